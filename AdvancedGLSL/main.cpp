@@ -1,9 +1,11 @@
 #include "window.h"
+#include "gl_state.h"
 #include "shader.h"
+#include "program_pipeline.h"
 #include "camera.h"
 #include "vertex_array.h"
 #include "vertex_buffer.h"
-#include "uniform_buffer.h"
+#include "uniform_ring.h"
 #include "texture.h"
 
 
@@ -133,13 +135,12 @@ namespace Hub
 			pointShader.setMatirx4("view", view);
 			pointShader.setMatirx4("projection", projection);
 
-			glBindVertexArray(*VAO);
+			GLState::bindVertexArray(*VAO);
 			glDrawArrays(GL_POINTS, 0, 4);
 
-			glBindVertexArray(0);
-			glfwSwapBuffers(window);
+			GLState::bindVertexArray(0);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 
 	void test2()
@@ -199,8 +200,7 @@ namespace Hub
 
 		auto VAO = VertexArray::create();
 		auto VBO = VertexBuffer::create(cubeVertices, sizeof(cubeVertices), BufferUsage::StaticDraw);
-		VAO->bindAttribute(0, 3, *VBO, Type::Float, 5 * sizeof(float), 0);
-		VAO->bindAttribute(1, 2, *VBO, Type::Float, 5 * sizeof(float), 3 * sizeof(float));
+		VAO->bindLayout(VertexLayouts::positionTexCoords, *VBO);
 		
 		const char* frontTexFile = "../Asset/container2.png";
 		const char* backTexFile = "../Asset/container.jpg";
@@ -243,29 +243,65 @@ namespace Hub
 			shader.setMatirx4("view", view);
 			shader.setMatirx4("projection", projection);
 
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *frontTex);
-			glActiveTexture(GL_TEXTURE1);
-			glBindTexture(GL_TEXTURE_2D, *backTex);
-			glBindVertexArray(*VAO);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *frontTex);
+			GLState::activeTexture(GL_TEXTURE1);
+			GLState::bindTexture(GL_TEXTURE_2D, *backTex);
+			GLState::bindVertexArray(*VAO);
 			glDrawArrays(GL_TRIANGLES, 0, 36);
 
-			glBindVertexArray(0);
-			glfwSwapBuffers(window);
+			GLState::bindVertexArray(0);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 
+	// uniform blocks of common.vs
+	struct Matrices : Std140::Block
+	{
+		Std140::Mat4 projection;
+		Std140::Mat4 view;
+	};
+	HUB_STD140_BLOCK(Matrices, projection, view);
+
+	struct Object : Std140::Block
+	{
+		Std140::Mat4 model;
+	};
+	HUB_STD140_BLOCK(Object, model);
+
 	void test3()
 	{
 		Window hWindow(windowWidth, windowHeight);
 		auto window = hWindow.getNativeHandle();
 		glfwSetCursorPosCallback(window, mouse_callback);
 		glfwSetScrollCallback(window, scroll_callback);
-		Shader redShader("./shader/common.vs", "./shader/red.fs");
-		Shader greenShader("./shader/common.vs", "./shader/green.fs");
-		Shader blueShader("./shader/common.vs", "./shader/blue.fs");
-		Shader yellowShader("./shader/common.vs", "./shader/yellow.fs");
+		const char* fragmentFiles[] = { "./shader/red.fs", "./shader/green.fs", "./shader/blue.fs", "./shader/yellow.fs" };
+
+		// separable stages: one vertex program and four fragment programs, combined without linking each pair.
+		// otherwise four full programs, common.vs is still compiled once and shared through ShaderStageCache
+		bool usePipelines = ProgramPipeline::isSupported();
+		SPProgramPipeline pipelines[4];
+		Shader shaders[4];
+		if (usePipelines)
+		{
+			auto vertexStage = ShaderStage::create(GL_VERTEX_SHADER, "./shader/common.vs");
+			vertexStage->bindUniformBlock("Matrices", 0);
+			vertexStage->bindUniformBlock("Object", 1);
+			for (int i = 0; i < 4; ++i)
+			{
+				pipelines[i] = ProgramPipeline::create(vertexStage, ShaderStage::create(GL_FRAGMENT_SHADER, fragmentFiles[i]));
+			}
+		}
+		else
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				shaders[i] = Shader("./shader/common.vs", fragmentFiles[i]);
+				// link each shader's uniform blocks to the uniform binding points
+				shaders[i].bindUniformBlock("Matrices", 0);
+				shaders[i].bindUniformBlock("Object", 1);
+			}
+		}
 
 		float cubeVertices[] = {
 			// positions         
@@ -313,19 +349,17 @@ namespace Hub
 		};
 		auto VAO = VertexArray::create();
 		auto VBO = VertexBuffer::create(cubeVertices, sizeof(cubeVertices), BufferUsage::StaticDraw);
-		VAO->bindAttribute(0, 3, *VBO, Type::Float, 3 * sizeof(float), 0);
+		VAO->bindLayout(VertexLayouts::position, *VBO);
 
 
-		// link each shader's uniform block to this uniform binding point
-		redShader.bindUniformBlock("Matrices", 0);
-		greenShader.bindUniformBlock("Matrices", 0);
-		blueShader.bindUniformBlock("Matrices", 0);
-		yellowShader.bindUniformBlock("Matrices", 0);
-
-		// create uniform buffer
-		auto UBO = UniformBuffer::create(nullptr, 2 * sizeof(glm::mat4), BufferUsage::StaticDraw);
-		// define the range of buffer that links to a uniform binding point
-		UBO->bindBufferRange(0, 0, 2 * sizeof(glm::mat4));
+		// every block of a frame is written to one mapped ring, draws pick their slice with bindBufferRange
+		auto uniforms = UniformRing::create(16 * 1024);
+		glm::vec3 offsets[] = {
+			glm::vec3(-0.75f, 0.75f, 0.0f),  // top left
+			glm::vec3(0.75f, 0.75f, 0.0f),   // top right
+			glm::vec3(-0.75f, -0.75f, 0.0f), // bottom left
+			glm::vec3(0.75f, -0.75f, 0.0f),  // bottom right
+		};
 
 		glEnable(GL_DEPTH_TEST);
 
@@ -341,41 +375,40 @@ namespace Hub
 			glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-			auto projection = camera.getProjectionMatrix(windowWidth / windowHeight * 1.0f);
-			UBO->subData(glm::value_ptr(projection), 0, sizeof(glm::mat4));
-			auto view = camera.getViewMatrix();
-			UBO->subData(glm::value_ptr(view), sizeof(glm::mat4), sizeof(glm::mat4));
-
-			glBindVertexArray(*VAO);
-
-			redShader.use();
-			auto model = glm::mat4(1.0);
-			model = glm::translate(model, glm::vec3(-0.75f, 0.75f, 0.0f));//top left
-			redShader.setMatirx4("model", model);
-			glDrawArrays(GL_TRIANGLES, 0, 36);
-
-			greenShader.use();
-			model = glm::mat4(1.0);
-			model = glm::translate(model, glm::vec3(0.75f, 0.75f, 0.0f)); // top right
-			greenShader.setMatirx4("model", model);
-			glDrawArrays(GL_TRIANGLES, 0, 36);
-
-			blueShader.use();
-			model = glm::mat4(1.0);
-			model = glm::translate(model, glm::vec3(-0.75f, -0.75f, 0.0f)); // bottom left
-			blueShader.setMatirx4("model", model);
-			glDrawArrays(GL_TRIANGLES, 0, 36);
-
-			yellowShader.use();
-			model = glm::mat4(1.0);
-			model = glm::translate(model, glm::vec3(0.75f, -0.75f, 0.0f)); // bottom right
-			yellowShader.setMatirx4("model", model);
-			glDrawArrays(GL_TRIANGLES, 0, 36);
-
-			glBindVertexArray(0);
-			glfwSwapBuffers(window);
+			uniforms->beginFrame();
+			Matrices matrices;
+			matrices.projection = camera.getProjectionMatrix(windowWidth / windowHeight * 1.0f);
+			matrices.view = camera.getViewMatrix();
+			auto matricesSlice = uniforms->push(matrices);
+			UniformRing::Slice objectSlices[4];
+			for (int i = 0; i < 4; ++i)
+			{
+				Object object;
+				object.model = glm::translate(glm::mat4(1.0), offsets[i]);
+				objectSlices[i] = uniforms->push(object);
+			}
+			uniforms->flush();
+
+			GLState::bindVertexArray(*VAO);
+			uniforms->bind(0, matricesSlice);
+			for (int i = 0; i < 4; ++i)
+			{
+				if (usePipelines)
+				{
+					pipelines[i]->use();
+				}
+				else
+				{
+					shaders[i].use();
+				}
+				uniforms->bind(1, objectSlices[i]);
+				glDrawArrays(GL_TRIANGLES, 0, 36);
+			}
+
+			GLState::bindVertexArray(0);
+			uniforms->endFrame();
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 
 }
@@ -7,7 +7,10 @@ layout(std140) uniform Matrices
 	mat4 view;
 };
 
-uniform mat4 model;
+layout(std140) uniform Object
+{
+	mat4 model;
+};
 
 void main()
 {
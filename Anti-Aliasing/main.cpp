@@ -1,11 +1,11 @@
 #include "window.h"
+#include "gl_state.h"
 #include "shader.h"
 #include "camera.h"
 #include "vertex_array.h"
 #include "vertex_buffer.h"
 #include "uniform_buffer.h"
-#include "frame_buffer.h"
-#include "render_buffer.h"
+#include "frame_graph.h"
 #include "texture.h"
 
 
@@ -136,7 +136,7 @@ namespace Hub
 
 		auto VAO = VertexArray::create();
 		auto VBO = VertexBuffer::create(cubeVertices, sizeof(cubeVertices), BufferUsage::StaticDraw);
-		VAO->bindAttribute(0, 3, *VBO, Type::Float, 3 * sizeof(float), 0);
+		VAO->bindLayout(VertexLayouts::position, *VBO);
 
 
 		glEnable(GL_DEPTH_TEST);
@@ -158,7 +158,7 @@ namespace Hub
 			auto view = camera.getViewMatrix();
 	
 
-			glBindVertexArray(*VAO);
+			GLState::bindVertexArray(*VAO);
 
 			shader.use();
 			shader.setMatirx4("projection", projection);
@@ -168,10 +168,9 @@ namespace Hub
 			shader.setMatirx4("model", model);
 			glDrawArrays(GL_TRIANGLES, 0, 36);
 
-			glBindVertexArray(0);
-			glfwSwapBuffers(window);
+			GLState::bindVertexArray(0);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 
 	void test2()
@@ -186,53 +185,21 @@ namespace Hub
 		// cube VAO
 		auto cubeVAO = VertexArray::create();
 		auto cubeVBO = VertexBuffer::create(cubeVertices, sizeof(cubeVertices), BufferUsage::StaticDraw);
-		cubeVAO->bindAttribute(0, 3, *cubeVBO, Type::Float, 3 * sizeof(float), 0);
+		cubeVAO->bindLayout(VertexLayouts::position, *cubeVBO);
 		
 		// screen VAO
 		auto quaVAO = VertexArray::create();
 		auto quaVBO = VertexBuffer::create(quadVertices, sizeof(quadVertices),BufferUsage::StaticDraw);
-		quaVAO->bindAttribute(0, 2, *quaVBO, Type::Float,4 * sizeof(float), 0);
-		quaVAO->bindAttribute(1, 2, *quaVBO, Type::Float,4 * sizeof(float), 2 * sizeof(float));
+		quaVAO->bindLayout(VertexLayouts::screenQuad, *quaVBO);
 		
-		// cfg MSAA framebuffer
-		auto FBO = FrameBuffer::create();
-		glBindFramebuffer(GL_FRAMEBUFFER, *FBO);
-		
-		// create a multisampled color attachment texture
-		auto textureColorBufferMultiSampled = Texture::create();
-		textureColorBufferMultiSampled->image2DMultisample(windowWidth, windowHeight);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D_MULTISAMPLE, *textureColorBufferMultiSampled, 0);
-		
-		// create a (also multisampled) renderbuffer object for depth and stencil attachments
-		auto RBO = RenderBuffer::create();
-		glBindRenderbuffer(GL_RENDERBUFFER, *RBO);
-		glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_DEPTH24_STENCIL8, windowWidth, windowHeight);
-		glBindRenderbuffer(GL_RENDERBUFFER, 0);
-		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, *RBO);
-		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-		{
-			std::cout << "ERROR::FRAMEBUFFER:: Intermediate framebuffer is not complete!" << std::endl;
-		}
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		// render targets follow the framebuffer size and are reused every frame
+		auto targets = RenderTargetPool::create();
+		auto graph = FrameGraph::create(targets);
 
-		// cfg second post-processing framebuffer
-		auto intermediateFBO = FrameBuffer::create();
-		glBindFramebuffer(GL_FRAMEBUFFER, *intermediateFBO);
-
-		// create a color attachment texture
-		auto screenTexture = Texture::create();
-		screenTexture->image2D(nullptr, Format::RGB, windowWidth, windowHeight, Type::UnsignedByte);
-
-		screenTexture->setFilter(Filter::operator_t::Min, Filter::filter_t::Linear);
-		screenTexture->setFilter(Filter::operator_t::Mag, Filter::filter_t::Linear);
-		
-		// we only need a clolr buffer
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, *screenTexture, 0);
-		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-		{
-			std::cout << "ERROR::FRAMEBUFFER:: Intermediate framebuffer is not complete!" << std::endl;
-		}
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		// MSAA framebuffer: multisampled color texture and depth/stencil renderbuffer
+		RenderTargetDesc msaaDesc;
+		msaaDesc.samples = 4;
+		msaaDesc.depth = DepthAttachment::RenderBuffer;
 
 		// shader cfg
 		shader.use();
@@ -247,50 +214,59 @@ namespace Hub
 			glfwPollEvents();
 			processInput(window);
 
-			glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+			graph->reset();
+			graph->setBackBufferSize(width, height);
 
 			// 1. draw scene as normal in multisampled buffers
-			glBindFramebuffer(GL_FRAMEBUFFER, *FBO);
-			glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-			glEnable(GL_DEPTH_TEST);
-
-			
-			auto projection = camera.getProjectionMatrix(windowWidth / windowHeight * 1.0f);
-			auto view = camera.getViewMatrix();
-
-			glBindVertexArray(*cubeVAO);
-			shader.use();
-			shader.setMatirx4("projection", projection);
-			shader.setMatirx4("view", view);
-			auto model = glm::mat4(1.0);
-			shader.setMatirx4("model", model);
-			glDrawArrays(GL_TRIANGLES, 0, 36);
-
-			// 2. now blit multisampled buffer to normal colorbuffer of intermediate FBO. Image is stored in screenTexture
-			glBindFramebuffer(GL_READ_FRAMEBUFFER, *FBO);
-			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, *intermediateFBO);
-			glBlitFramebuffer(0, 0, windowWidth, windowHeight, 0, 0, windowWidth, windowHeight,GL_COLOR_BUFFER_BIT, GL_NEAREST);
-
+			FrameGraph::Resource scene = FrameGraph::InvalidResource;
+			graph->addPass("scene",
+				[&](FrameGraph::Builder& builder) { scene = builder.create("msaa", msaaDesc); },
+				[&](FrameGraph::Context&) {
+					glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+					glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+					glEnable(GL_DEPTH_TEST);
+
+					auto projection = camera.getProjectionMatrix(windowWidth / windowHeight * 1.0f);
+					auto view = camera.getViewMatrix();
+
+					GLState::bindVertexArray(*cubeVAO);
+					shader.use();
+					shader.setMatirx4("projection", projection);
+					shader.setMatirx4("view", view);
+					auto model = glm::mat4(1.0);
+					shader.setMatirx4("model", model);
+					glDrawArrays(GL_TRIANGLES, 0, 36);
+				});
+
+			// 2. the graph blits the multisampled buffer to a normal color buffer before it is sampled
 			// 3. now render quad with scene's visuals as its texture image
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
-			glClearColor(1.0, 1.0, 1.0, 1.0);
-			glClear(GL_COLOR_BUFFER_BIT);
-			glDisable(GL_DEPTH_TEST);
-			
-			// draw scene quad
-			screenShader.use();
-			glBindVertexArray(*quaVAO);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *screenTexture);
-			glDrawArrays(GL_TRIANGLES, 0, 6);
-			
-
-			glBindVertexArray(0);
-			glfwSwapBuffers(window);
+			graph->addPass("screen",
+				[&](FrameGraph::Builder& builder) {
+					builder.read(scene);
+					builder.writeBackBuffer();
+				},
+				[&](FrameGraph::Context& context) {
+					glClearColor(1.0, 1.0, 1.0, 1.0);
+					glClear(GL_COLOR_BUFFER_BIT);
+					glDisable(GL_DEPTH_TEST);
+
+					// draw scene quad
+					screenShader.use();
+					GLState::bindVertexArray(*quaVAO);
+					GLState::activeTexture(GL_TEXTURE0);
+					GLState::bindTexture(GL_TEXTURE_2D, *context.getTexture(scene));
+					glDrawArrays(GL_TRIANGLES, 0, 6);
+				});
+
+			graph->compile();
+			graph->execute();
+
+			GLState::bindVertexArray(0);
+			targets->newFrame();
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 
 }
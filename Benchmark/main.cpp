@@ -0,0 +1,255 @@
+#include "window.h"
+#include "gl_state.h"
+#include "shader.h"
+#include "vertex_array.h"
+#include "vertex_buffer.h"
+#include "streaming_buffer.h"
+#include "async_readback.h"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+namespace Hub
+{
+	int windowWidth = 800;
+	int windowHeight = 600;
+	const int warmupFrames = 60;
+	const int measureFrames = 600;
+
+	// run frame() for warmupFrames + measureFrames and return the average cpu time of a measured frame in ms
+	double measure(Window& hWindow, const std::function<void()>& frame)
+	{
+		double start = 0.0;
+		for (int i = 0; i < warmupFrames + measureFrames && !hWindow.shouldClose(); ++i)
+		{
+			if (i == warmupFrames)
+			{
+				glFinish();
+				start = glfwGetTime();
+			}
+			glfwPollEvents();
+			glClear(GL_COLOR_BUFFER_BIT);
+			frame();
+			hWindow.swapBuffer();
+		}
+		glFinish();
+		return (glfwGetTime() - start) * 1000.0 / measureFrames;
+	}
+
+	// per-frame vertex upload: Buffer::subData against the fenced StreamingBuffer ring
+	void benchStreamingBuffer()
+	{
+		Window hWindow(windowWidth, windowHeight, "Benchmark: StreamingBuffer");
+		glfwSwapInterval(0);
+		Shader shader("./shader/stream.vs", "./shader/stream.fs");
+
+		const size_t pointCount = 64 * 1024;
+		const size_t dataSize = pointCount * sizeof(glm::vec4);
+		std::vector<glm::vec4> points(pointCount);
+		int frameNumber = 0;
+		auto fillPoints = [&]()
+		{
+			float t = static_cast<float>(frameNumber++) * 0.01f;
+			for (size_t i = 0; i < pointCount; ++i)
+			{
+				float x = static_cast<float>(i % 256) / 128.0f - 1.0f;
+				float y = static_cast<float>(i / 256) / 128.0f - 1.0f;
+				points[i] = glm::vec4(x + 0.01f * glm::sin(t + y), y, 0.0f, 1.0f);
+			}
+		};
+
+		auto subDataVAO = VertexArray::create();
+		auto subDataVBO = VertexBuffer::create(nullptr, dataSize, BufferUsage::StreamDraw);
+		subDataVAO->bindAttribute(0, 4, *subDataVBO, Type::Float, sizeof(glm::vec4), 0);
+		double subDataTime = measure(hWindow, [&]()
+		{
+			fillPoints();
+			subDataVBO->subData(points.data(), 0, dataSize);
+			shader.use();
+			GLState::bindVertexArray(*subDataVAO);
+			glDrawArrays(GL_POINTS, 0, pointCount);
+		});
+
+		// 顶点数组只设置一次，每帧的分配按 vec4 对齐，用 first 顶点指向它
+		auto streamVAO = VertexArray::create();
+		auto streamVBO = StreamingBuffer::create(Buffer::ArrayBuffer, dataSize);
+		streamVAO->bindAttribute(0, 4, *streamVBO, Type::Float, sizeof(glm::vec4), 0);
+		double streamTime = measure(hWindow, [&]()
+		{
+			streamVBO->beginFrame();
+			fillPoints();
+			auto allocation = streamVBO->write(points.data(), dataSize, sizeof(glm::vec4));
+			streamVBO->flush();
+			shader.use();
+			GLState::bindVertexArray(*streamVAO);
+			glDrawArrays(GL_POINTS, static_cast<GLint>(allocation.offset / sizeof(glm::vec4)), pointCount);
+			streamVBO->endFrame();
+		});
+		GLState::bindVertexArray(0);
+
+		std::cout << "[StreamingBuffer] " << pointCount << " vec4 per frame" << std::endl;
+		std::cout << "  subData:         " << subDataTime << " ms/frame" << std::endl;
+		std::cout << "  StreamingBuffer: " << streamTime << " ms/frame ("
+			<< (streamVBO->isPersistent() ? "persistent" : "unsynchronized/orphan") << ")" << std::endl;
+		auto& stats = GLState::getFrameStats();
+		std::cout << "  binds issued/skipped per frame: " << stats.issued << "/" << stats.skipped << std::endl;
+	}
+
+	// full framebuffer read every frame: blocking glReadPixels against AsyncReadback
+	void benchReadback()
+	{
+		Window hWindow(windowWidth, windowHeight, "Benchmark: AsyncReadback");
+		glfwSwapInterval(0);
+
+		std::vector<unsigned char> pixels(windowWidth * windowHeight * 4);
+		int frameNumber = 0;
+		auto clearFrame = [&]()
+		{
+			float t = static_cast<float>(frameNumber++) * 0.01f;
+			glClearColor(0.5f + 0.5f * glm::sin(t), 0.2f, 0.3f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+		};
+
+		double syncTime = measure(hWindow, [&]()
+		{
+			clearFrame();
+			glReadPixels(0, 0, windowWidth, windowHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		});
+
+		auto readback = AsyncReadback::create();
+		uint completed = 0;
+		double asyncTime = measure(hWindow, [&]()
+		{
+			clearFrame();
+			readback->readPixels(0, GL_BACK, 0, 0, windowWidth, windowHeight, GL_RGBA, GL_UNSIGNED_BYTE,
+				[&](const AsyncReadback::Data&) { ++completed; });
+			readback->update();
+		});
+		uint pending = readback->getPendingCount();
+		readback->finish();
+
+		std::cout << "[AsyncReadback] " << windowWidth << "x" << windowHeight << " RGBA8 per frame" << std::endl;
+		std::cout << "  glReadPixels:  " << syncTime << " ms/frame" << std::endl;
+		std::cout << "  AsyncReadback: " << asyncTime << " ms/frame (" << completed << " completed, "
+			<< pending << " in flight at the end)" << std::endl;
+	}
+
+	// LightMultiple style per-light struct uniforms, set every frame through three paths:
+	// glGetUniformLocation on built names, the reflected table on built names, and handles resolved once
+	void benchUniforms()
+	{
+		Window hWindow(windowWidth, windowHeight, "Benchmark: Uniforms");
+		glfwSwapInterval(0);
+		Shader shader("./shader/lights.vs", "./shader/lights.fs");
+		auto emptyVAO = VertexArray::create();
+
+		const int lightCount = 16;
+		const int repeat = 16; // uniform updates per frame are lightCount * 7 * repeat
+		auto lightPosition = [](int i)
+		{
+			float angle = static_cast<float>(i) / lightCount * 6.2831853f;
+			return glm::vec3(glm::cos(angle), glm::sin(angle), 0.5f);
+		};
+		auto draw = [&]()
+		{
+			GLState::bindVertexArray(*emptyVAO);
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		};
+
+		double locationTime = measure(hWindow, [&]()
+		{
+			shader.use();
+			GLuint program = shader._programID;
+			for (int r = 0; r < repeat; ++r)
+			{
+				for (int i = 0; i < lightCount; ++i)
+				{
+					auto aim = "pointLights[" + std::to_string(i) + "].";
+					glm::vec3 position = lightPosition(i);
+					glUniform3f(glGetUniformLocation(program, (aim + "position").c_str()),
+						position.x, position.y, position.z);
+					glUniform3f(glGetUniformLocation(program, (aim + "ambient").c_str()), 0.05f, 0.05f, 0.05f);
+					glUniform3f(glGetUniformLocation(program, (aim + "diffuse").c_str()), 0.8f, 0.8f, 0.8f);
+					glUniform3f(glGetUniformLocation(program, (aim + "specular").c_str()), 1.0f, 1.0f, 1.0f);
+					glUniform1f(glGetUniformLocation(program, (aim + "constant").c_str()), 1.0f);
+					glUniform1f(glGetUniformLocation(program, (aim + "linear").c_str()), 0.09f);
+					glUniform1f(glGetUniformLocation(program, (aim + "quadratic").c_str()), 0.032f);
+				}
+			}
+			draw();
+		});
+
+		double tableTime = measure(hWindow, [&]()
+		{
+			shader.use();
+			for (int r = 0; r < repeat; ++r)
+			{
+				for (int i = 0; i < lightCount; ++i)
+				{
+					auto aim = "pointLights[" + std::to_string(i) + "].";
+					shader.setVec3((aim + "position").c_str(), lightPosition(i));
+					shader.setVec3((aim + "ambient").c_str(), 0.05f, 0.05f, 0.05f);
+					shader.setVec3((aim + "diffuse").c_str(), 0.8f, 0.8f, 0.8f);
+					shader.setVec3((aim + "specular").c_str(), 1.0f, 1.0f, 1.0f);
+					shader.setFloat((aim + "constant").c_str(), 1.0f);
+					shader.setFloat((aim + "linear").c_str(), 0.09f);
+					shader.setFloat((aim + "quadratic").c_str(), 0.032f);
+				}
+			}
+			draw();
+		});
+
+		struct PointLightUniforms
+		{
+			UniformHandle position, ambient, diffuse, specular, constant, linear, quadratic;
+		};
+		std::vector<PointLightUniforms> uniforms(lightCount);
+		for (int i = 0; i < lightCount; ++i)
+		{
+			auto aim = "pointLights[" + std::to_string(i) + "].";
+			uniforms[i] = { shader.getUniform(aim + "position"), shader.getUniform(aim + "ambient"),
+				shader.getUniform(aim + "diffuse"), shader.getUniform(aim + "specular"),
+				shader.getUniform(aim + "constant"), shader.getUniform(aim + "linear"),
+				shader.getUniform(aim + "quadratic") };
+		}
+		double handleTime = measure(hWindow, [&]()
+		{
+			shader.use();
+			for (int r = 0; r < repeat; ++r)
+			{
+				for (int i = 0; i < lightCount; ++i)
+				{
+					shader.setVec3(uniforms[i].position, lightPosition(i));
+					shader.setVec3(uniforms[i].ambient, 0.05f, 0.05f, 0.05f);
+					shader.setVec3(uniforms[i].diffuse, 0.8f, 0.8f, 0.8f);
+					shader.setVec3(uniforms[i].specular, 1.0f, 1.0f, 1.0f);
+					shader.setFloat(uniforms[i].constant, 1.0f);
+					shader.setFloat(uniforms[i].linear, 0.09f);
+					shader.setFloat(uniforms[i].quadratic, 0.032f);
+				}
+			}
+			draw();
+		});
+		auto handleStats = Shader::getFrameUniformStats();
+		GLState::bindVertexArray(0);
+
+		std::cout << "[Uniforms] " << lightCount * 7 * repeat << " point light uniforms per frame" << std::endl;
+		std::cout << "  glGetUniformLocation: " << locationTime << " ms/frame" << std::endl;
+		std::cout << "  reflected table:      " << tableTime << " ms/frame" << std::endl;
+		std::cout << "  UniformHandle:        " << handleTime << " ms/frame" << std::endl;
+		std::cout << "  glUniform calls per frame: " << handleStats.issued << " issued, " << handleStats.elided
+			<< " elided (unchanged values)" << std::endl;
+	}
+}
+
+
+int main()
+{
+	Hub::benchStreamingBuffer();
+	Hub::benchReadback();
+	Hub::benchUniforms();
+	return 0;
+}
@@ -0,0 +1,36 @@
+#version 330 core
+
+out vec4 FragColor;
+in vec3 FragPos;
+
+// same struct as LightMultiple, with more lights
+struct PointLight
+{
+	vec3 position;
+
+	float constant;
+	float linear;
+	float quadratic;
+
+	vec3 ambient;
+	vec3 diffuse;
+	vec3 specular;
+};
+#define NR_POINT_LIGHTS 16
+uniform PointLight pointLights[NR_POINT_LIGHTS];
+
+void main()
+{
+	vec3 normal = vec3(0.0, 0.0, 1.0);
+	vec3 result = vec3(0.0);
+	for (int i = 0; i < NR_POINT_LIGHTS; ++i)
+	{
+		PointLight light = pointLights[i];
+		vec3 lightDir = normalize(light.position - FragPos);
+		float distance = length(light.position - FragPos);
+		float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
+		float diff = max(dot(normal, lightDir), 0.0);
+		result += (light.ambient + light.diffuse * diff + light.specular * diff * diff) * attenuation;
+	}
+	FragColor = vec4(result / NR_POINT_LIGHTS, 1.0);
+}
@@ -0,0 +1,11 @@
+#version 330 core
+
+out vec3 FragPos;
+
+// full screen triangle, no vertex buffer needed
+void main()
+{
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+	FragPos = vec3(position, 0.0);
+	gl_Position = vec4(position, 0.0, 1.0);
+}
@@ -1,4 +1,5 @@
 #include "window.h"
+#include "gl_state.h"
 #include "shader.h"
 #include "camera.h"
 #include "vertex_array.h"
@@ -103,9 +104,7 @@ namespace Hub
 		auto VAO = VertexArray::create();
 		auto VBO = VertexBuffer::create(planeVertices, sizeof(planeVertices), BufferUsage::StaticDraw);
 
-		VAO->bindAttribute(0, 3, *VBO, Type::Float, 8 * sizeof(float), 0);
-		VAO->bindAttribute(1, 3, *VBO, Type::Float, 8 * sizeof(float), 3 * sizeof(float));
-		VAO->bindAttribute(2, 2, *VBO, Type::Float, 8 * sizeof(float), 6 * sizeof(float));
+		VAO->bindLayout(VertexLayouts::positionNormalTexCoords, *VBO);
 
 		const char* filePath = "../Asset/wood.png";
 		auto floorTexture = Texture::create(filePath);
@@ -142,9 +141,9 @@ namespace Hub
 			shader.setVec3("lightPos", lightPos);
 			shader.setInt("blinn", blinn);
 
-			glBindVertexArray(*VAO);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *floorTexture);
+			GLState::bindVertexArray(*VAO);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *floorTexture);
 			glDrawArrays(GL_TRIANGLES, 0, 6);
 
 			if (blinn^beforeMode)
@@ -152,10 +151,9 @@ namespace Hub
 				std::cout << (blinn ? "Blinn-Phong" : "Phong") << std::endl;
 				beforeMode = blinn;
 			}
-			glBindVertexArray(0);
-			glfwSwapBuffers(window);
+			GLState::bindVertexArray(0);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 
 }
@@ -1,4 +1,5 @@
 ﻿#include "window.h"
+#include "gl_state.h"
 #include "image.h"
 #include "texture.h"
 #include "shader.h"
@@ -128,10 +129,10 @@ namespace Hub
 		glGenBuffers(1, &VBO); // 生成顶点缓冲对象
 
 		// 绑定VAO
-		glBindVertexArray(VAO);
+		GLState::bindVertexArray(VAO);
 
 		// 绑定缓冲类型
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, VBO);
 		// 复制顶点数据到缓冲
 		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
@@ -144,9 +145,9 @@ namespace Hub
 		glEnableVertexAttribArray(1);
 
 		// unbind
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
 		// 解绑VAO
-		glBindVertexArray(0);
+		GLState::bindVertexArray(0);
 
 		const char* filePath = "../Asset/container.jpg";
 		auto image1 = Image::create(filePath);
@@ -167,11 +168,11 @@ namespace Hub
 
 		ourShader.use(); // 设置shader属性前需要激活程序
 		// 绑定纹理
-		glActiveTexture(GL_TEXTURE0); // 使用一个纹理时默认激活
-		glBindTexture(GL_TEXTURE_2D, *texture1);
+		GLState::activeTexture(GL_TEXTURE0); // 使用一个纹理时默认激活
+		GLState::bindTexture(GL_TEXTURE_2D, *texture1);
 		ourShader.setInt("ourTexture1", 0);
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, *texture2);
+		GLState::activeTexture(GL_TEXTURE1);
+		GLState::bindTexture(GL_TEXTURE_2D, *texture2);
 		ourShader.setInt("ourTexture2", 1);
 
 		// 开启深度测试
@@ -200,7 +201,7 @@ namespace Hub
 			glClearColor(0.2f, 0.3f, 0.3f, 1.0f); // 清除颜色缓冲后需要填入的颜色，是一个状态设置函数
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // 每次渲染迭代清除颜色缓冲和深度缓冲
 
-			glBindVertexArray(VAO);
+			GLState::bindVertexArray(VAO);
 
 			auto count = positions.size();
 			for (size_t i = 0; i < count; ++i)
@@ -221,16 +222,15 @@ namespace Hub
 			projection = glm::perspective(camera.getFov(), windowWidth / windowHight * 1.0f, 0.1f, 100.0f);
 			ourShader.setMatirx4("projection", projection);
 
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
 			// swap the screen buffers
-			glfwSwapBuffers(window);
+			hWindow.swapBuffer();
 
 		}
 		// 结束后回收所有分配的资源
 		glDeleteVertexArrays(1, &VAO);
 		glDeleteBuffers(1, &VBO);
-		glfwTerminate();
 	}
 }
 
@@ -13,7 +13,8 @@ namespace Hub
         {
             destory();
 
-            glfwTerminate();
+            // the window releases the GL objects and terminates glfw
+            _currentWindow.reset();
         }
 
         void init();
@@ -0,0 +1,194 @@
+#include "async_readback.h"
+#include "gl_state.h"
+
+namespace Hub
+{
+    static const GLuint64 s_finishTimeout = 1000000; // 1ms per wait, retried until signaled
+
+    // GPU side destination of a readback, sized to the largest request it served
+    class AsyncReadback::StagingBuffer final : public Buffer
+    {
+    public:
+        StagingBuffer(size_t capacity) : Buffer(buffer_t::ArrayBuffer), capacity(capacity)
+        {
+            data(nullptr, capacity, BufferUsage::StreamRead);
+        }
+
+        size_t capacity;
+    };
+
+    SPAsyncReadback AsyncReadback::create()
+    {
+        return SPAsyncReadback(new AsyncReadback());
+    }
+
+    AsyncReadback::~AsyncReadback()
+    {
+        for (auto& request : _pending)
+        {
+            glDeleteSync(request.fence);
+        }
+    }
+
+    void AsyncReadback::readBuffer(const Buffer& buffer, size_t offset, size_t length, Callback callback)
+    {
+        auto staging = acquire(length);
+        staging->copySubData(buffer, offset, 0, length);
+        submit(staging, length, std::move(callback));
+    }
+
+    std::future<AsyncReadback::Data> AsyncReadback::readBuffer(const Buffer& buffer, size_t offset, size_t length)
+    {
+        auto promise = std::make_shared<std::promise<Data>>();
+        readBuffer(buffer, offset, length, [promise](const Data& data) { promise->set_value(data); });
+        return promise->get_future();
+    }
+
+    void AsyncReadback::readPixels(GLuint   frameBuffer,
+                                   GLenum   readBuffer,
+                                   int      x,
+                                   int      y,
+                                   int      width,
+                                   int      height,
+                                   GLenum   format,
+                                   GLenum   type,
+                                   Callback callback)
+    {
+        uint components = 4;
+        switch (format)
+        {
+            case GL_RED:
+            case GL_DEPTH_COMPONENT:
+            case GL_STENCIL_INDEX:
+            case GL_DEPTH_STENCIL:
+                components = 1;
+                break;
+            case GL_RG:
+                components = 2;
+                break;
+            case GL_RGB:
+            case GL_BGR:
+                components = 3;
+                break;
+        }
+        uint componentSize = type == GL_UNSIGNED_INT_24_8 ? 4 : Type::sizeOf(static_cast<Type::type_t>(type));
+        // rows are packed tightly, see GL_PACK_ALIGNMENT below
+        size_t length = size_t(width) * height * components * componentSize;
+
+        GLint previousFrameBuffer = 0;
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousFrameBuffer);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, frameBuffer);
+        glReadBuffer(readBuffer);
+
+        // with a pack buffer bound glReadPixels only queues the copy and returns
+        auto staging = acquire(length);
+        GLState::bindBuffer(GL_PIXEL_PACK_BUFFER, *staging);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(x, y, width, height, format, type, nullptr);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        GLState::bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, previousFrameBuffer);
+        submit(staging, length, std::move(callback));
+    }
+
+    std::future<AsyncReadback::Data> AsyncReadback::readPixels(GLuint frameBuffer,
+                                                               GLenum readBuffer,
+                                                               int    x,
+                                                               int    y,
+                                                               int    width,
+                                                               int    height,
+                                                               GLenum format,
+                                                               GLenum type)
+    {
+        auto promise = std::make_shared<std::promise<Data>>();
+        readPixels(frameBuffer, readBuffer, x, y, width, height, format, type, [promise](const Data& data) {
+            promise->set_value(data);
+        });
+        return promise->get_future();
+    }
+
+    void AsyncReadback::update()
+    {
+        // requests complete in submission order
+        while (!_pending.empty())
+        {
+            auto& request = _pending.front();
+            // the first poll also flushes, otherwise the fence may never reach the GPU
+            GLbitfield flags = request.flushed ? 0 : GL_SYNC_FLUSH_COMMANDS_BIT;
+            request.flushed  = true;
+            GLenum result    = glClientWaitSync(request.fence, flags, 0);
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            {
+                break;
+            }
+            complete(request);
+            _pending.pop_front();
+        }
+    }
+
+    void AsyncReadback::finish()
+    {
+        while (!_pending.empty())
+        {
+            auto&  request = _pending.front();
+            GLenum result  = glClientWaitSync(request.fence, GL_SYNC_FLUSH_COMMANDS_BIT, s_finishTimeout);
+            while (result == GL_TIMEOUT_EXPIRED)
+            {
+                result = glClientWaitSync(request.fence, GL_SYNC_FLUSH_COMMANDS_BIT, s_finishTimeout);
+            }
+            complete(request);
+            _pending.pop_front();
+        }
+    }
+
+    uint AsyncReadback::getPendingCount() const
+    {
+        return static_cast<uint>(_pending.size());
+    }
+
+    AsyncReadback::SPStagingBuffer AsyncReadback::acquire(size_t length)
+    {
+        // smallest free buffer that fits, staging buffers are recycled once their request completed
+        auto best = _free.end();
+        for (auto it = _free.begin(); it != _free.end(); ++it)
+        {
+            if ((*it)->capacity >= length && (best == _free.end() || (*it)->capacity < (*best)->capacity))
+            {
+                best = it;
+            }
+        }
+        if (best == _free.end())
+        {
+            return std::make_shared<StagingBuffer>(length);
+        }
+        auto staging = *best;
+        _free.erase(best);
+        return staging;
+    }
+
+    void AsyncReadback::submit(SPStagingBuffer staging, size_t length, Callback callback)
+    {
+        Request request;
+        request.staging  = staging;
+        request.length   = length;
+        request.fence    = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        request.callback = std::move(callback);
+        _pending.push_back(std::move(request));
+    }
+
+    void AsyncReadback::complete(Request& request)
+    {
+        glDeleteSync(request.fence);
+        request.fence = nullptr;
+
+        // the copy has finished, reading the staging buffer does not wait on the GPU any more
+        Data data(request.length);
+        request.staging->getSubData(data.data(), 0, request.length);
+        _free.push_back(request.staging);
+        if (request.callback)
+        {
+            request.callback(data);
+        }
+    }
+} // namespace Hub
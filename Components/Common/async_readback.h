@@ -0,0 +1,80 @@
+#pragma once
+#include "utils.h"
+#include "buffer.h"
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace Hub
+{
+    class AsyncReadback;
+    using SPAsyncReadback = std::shared_ptr<AsyncReadback>;
+
+    // Reads buffers and framebuffers back without stalling. A request only records a GPU copy into a staging
+    // buffer and a fence; update() hands the data over once the fence has signaled, usually a frame or two
+    // later. Results arrive on the GL thread, inside update().
+    class AsyncReadback
+    {
+    public:
+        using Data     = std::vector<unsigned char>;
+        using Callback = std::function<void(const Data& data)>;
+
+        static SPAsyncReadback create();
+
+        ~AsyncReadback();
+
+        // buffer range, e.g. transform feedback output
+        void              readBuffer(const Buffer& buffer, size_t offset, size_t length, Callback callback);
+        std::future<Data> readBuffer(const Buffer& buffer, size_t offset, size_t length);
+
+        // rectangle of a color (or depth) attachment, frameBuffer 0 is the default framebuffer
+        void readPixels(GLuint   frameBuffer,
+                        GLenum   readBuffer,
+                        int      x,
+                        int      y,
+                        int      width,
+                        int      height,
+                        GLenum   format,
+                        GLenum   type,
+                        Callback callback);
+        std::future<Data> readPixels(GLuint frameBuffer,
+                                     GLenum readBuffer,
+                                     int    x,
+                                     int    y,
+                                     int    width,
+                                     int    height,
+                                     GLenum format,
+                                     GLenum type);
+
+        // completes every request whose copy has finished, call once per frame
+        void update();
+        // blocks until every pending request has completed
+        void finish();
+
+        uint getPendingCount() const;
+
+    private:
+        class StagingBuffer;
+        using SPStagingBuffer = std::shared_ptr<StagingBuffer>;
+
+        struct Request
+        {
+            SPStagingBuffer staging;
+            size_t          length  = 0;
+            GLsync          fence   = nullptr;
+            bool            flushed = false;
+            Callback        callback;
+        };
+
+        AsyncReadback() = default;
+
+        SPStagingBuffer acquire(size_t length);
+        void            submit(SPStagingBuffer staging, size_t length, Callback callback);
+        void            complete(Request& request);
+
+        std::deque<Request>          _pending;
+        std::vector<SPStagingBuffer> _free;
+    };
+} // namespace Hub
@@ -1,15 +1,28 @@
 #include "buffer.h"
+#include "gl_state.h"
+#include "gl_deletion_queue.h"
+#include "gl_extensions.h"
+#include "vertex_format_cache.h"
 
 namespace Hub
 {
-    Buffer::Buffer(buffer_t bufferType) : _bufferType(bufferType)
+    Buffer::Buffer(buffer_t bufferType) : _bufferType(bufferType), _dsa(GLExtensions::get().directStateAccess)
     {
-        glGenBuffers(1, &_obj);
+        if (_dsa)
+        {
+            glCreateBuffers(1, &_obj);
+        }
+        else
+        {
+            glGenBuffers(1, &_obj);
+        }
     }
 
     Buffer::~Buffer()
     {
-        glDeleteBuffers(1, &_obj);
+        GLState::onDeleteBuffer(_obj);
+        VertexFormatCache::onDeleteBuffer(_obj);
+        GLDeletionQueue::release(GLObject::Buffer, _obj);
     }
 
     Buffer::operator GLuint() const
@@ -19,20 +32,47 @@ namespace Hub
 
     void Buffer::data(const void* data, size_t length, BufferUsage::buffer_usage_t usage)
     {
-        glBindBuffer(_bufferType, _obj);
-        glBufferData(_bufferType, length, data, usage);
+        if (_dsa)
+        {
+            glNamedBufferData(_obj, length, data, usage);
+            return;
+        }
+        GLenum target = bindForEdit();
+        glBufferData(target, length, data, usage);
     }
 
     void Buffer::subData(const void* data, size_t offset, size_t length)
     {
-        glBindBuffer(_bufferType, _obj);
-        glBufferSubData(_bufferType, offset, length, data);
+        if (_dsa)
+        {
+            glNamedBufferSubData(_obj, offset, length, data);
+            return;
+        }
+        GLenum target = bindForEdit();
+        glBufferSubData(target, offset, length, data);
     }
 
     void Buffer::getSubData(void* data, size_t offset, size_t length)
     {
-        glBindBuffer(_bufferType, _obj);
-        glGetBufferSubData(_bufferType, offset, length, data);
+        if (_dsa)
+        {
+            glGetNamedBufferSubData(_obj, offset, length, data);
+            return;
+        }
+        GLenum target = bindForEdit();
+        glGetBufferSubData(target, offset, length, data);
+    }
+
+    void Buffer::copySubData(const Buffer& source, size_t readOffset, size_t writeOffset, size_t length)
+    {
+        if (_dsa)
+        {
+            glCopyNamedBufferSubData(source, _obj, readOffset, writeOffset, length);
+            return;
+        }
+        GLState::bindBuffer(GL_COPY_READ_BUFFER, source);
+        GLState::bindBuffer(GL_COPY_WRITE_BUFFER, _obj);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, readOffset, writeOffset, length);
     }
 
     Buffer::Buffer(buffer_t bufferType, const void* data, size_t length, BufferUsage::buffer_usage_t usage) :
@@ -40,4 +80,12 @@ namespace Hub
     {
         this->data(data, length, usage);
     }
+
+    GLenum Buffer::bindForEdit() const
+    {
+        // the element array binding belongs to the bound vertex array, edit through a neutral target instead
+        GLenum target = _bufferType == ElementArrayBuffer ? GL_COPY_WRITE_BUFFER : _bufferType;
+        GLState::bindBuffer(target, _obj);
+        return target;
+    }
 } // namespace Hub
\ No newline at end of file
@@ -27,6 +27,8 @@ namespace Hub
         void data(const void* data, size_t length, BufferUsage::buffer_usage_t usage);
         void subData(const void* data, size_t offset, size_t length);
         void getSubData(void* data, size_t offset, size_t length);
+        // GPU side copy from source, source may be this buffer if the ranges do not overlap
+        void copySubData(const Buffer& source, size_t readOffset, size_t writeOffset, size_t length);
 
         enum buffer_t
         {
@@ -38,8 +40,12 @@ namespace Hub
     protected:
         Buffer(buffer_t bufferType);
         Buffer(buffer_t bufferType, const void* data, size_t length, BufferUsage::buffer_usage_t usage);
+        // binds the buffer for uploads and returns the target it was bound to
+        GLenum bindForEdit() const;
+
         GLuint   _obj;
         buffer_t _bufferType;
+        bool     _dsa; // created with glCreateBuffers and edited through the named buffer api
     };
 
 } // namespace Hub
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "cooked_model.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Hub
+{
+    struct CookedModel::Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vertexStride;
+        uint32_t meshCount;
+        uint32_t textureCount;
+        uint32_t stringsSize;
+        uint32_t indexSize; // 2 or 4 bytes
+        uint32_t vertexFormat; // MeshData::VertexFormat
+        uint32_t lodCount;     // MeshData::ImportOptions, a mesh may have fewer
+        float    lodError;
+        uint64_t sourceSize;
+        int64_t  sourceTime;
+        uint64_t stringsOffset;
+        uint64_t verticesOffset;
+        uint64_t vertexCount;
+        uint64_t indicesOffset;
+        uint64_t indexCount;
+        float    boundsMin[3];
+        float    boundsMax[3];
+    };
+
+    struct CookedModel::MeshRecord
+    {
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+        uint32_t firstIndex;
+        uint32_t indexCount; // every level, back to back
+        uint32_t firstTexture;
+        uint32_t textureCount;
+        float    boundsMin[3];
+        float    boundsMax[3];
+        uint32_t lodCount;
+        uint32_t lodIndexCount[MeshData::MaxLods];
+        float    lodError[MeshData::MaxLods];
+    };
+
+    struct CookedModel::TextureRecord
+    {
+        uint32_t typeOffset;
+        uint32_t typeLength;
+        uint32_t pathOffset;
+        uint32_t pathLength;
+    };
+
+    namespace
+    {
+        const uint32_t CookedMagic = 0x4D425548; // "HUBM"
+
+        uint64_t alignUp(uint64_t value)
+        {
+            return (value + 15) / 16 * 16;
+        }
+
+        // size and write time of the source, both 0 when it does not exist
+        void sourceStamp(const std::string& sourcePath, uint64_t& size, int64_t& time)
+        {
+            std::error_code error;
+            size = std::filesystem::file_size(sourcePath, error);
+            if (error)
+            {
+                size = 0;
+                time = 0;
+                return;
+            }
+            time = std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count();
+        }
+
+        void copyBounds(const MeshData::Bounds& bounds, float* min, float* max)
+        {
+            std::memcpy(min, &bounds.min, sizeof(float) * 3);
+            std::memcpy(max, &bounds.max, sizeof(float) * 3);
+        }
+
+        MeshData::Bounds toBounds(const float* min, const float* max)
+        {
+            MeshData::Bounds bounds;
+            bounds.min = Vector3(min[0], min[1], min[2]);
+            bounds.max = Vector3(max[0], max[1], max[2]);
+            return bounds;
+        }
+    } // namespace
+
+    std::string CookedModel::pathFor(const std::string& sourcePath)
+    {
+        return sourcePath + ".hubmesh";
+    }
+
+    bool CookedModel::write(const std::string&             path,
+                            const std::string&             sourcePath,
+                            const MeshData::ImportOptions& options,
+                            const std::vector<CookedMesh>& meshes)
+    {
+        Header header{};
+        header.magic        = CookedMagic;
+        header.version      = Version;
+        header.vertexStride = MeshData::layoutOf(options.vertexFormat).getStride();
+        header.vertexFormat = options.vertexFormat;
+        header.lodCount     = options.lodCount;
+        header.lodError     = options.lodError;
+        header.meshCount    = static_cast<uint32_t>(meshes.size());
+        header.indexSize    = 2;
+        sourceStamp(sourcePath, header.sourceSize, header.sourceTime);
+
+        std::vector<MeshRecord>    records;
+        std::vector<TextureRecord> textures;
+        std::string                strings;
+        MeshData::Bounds           bounds;
+        auto                       addString = [&](const std::string& value, uint32_t& offset, uint32_t& length) {
+            offset = static_cast<uint32_t>(strings.size());
+            length = static_cast<uint32_t>(value.size());
+            strings += value;
+        };
+        for (const auto& mesh : meshes)
+        {
+            MeshRecord record{};
+            record.firstVertex  = static_cast<uint32_t>(header.vertexCount);
+            record.vertexCount  = mesh.vertexCount;
+            record.firstIndex   = static_cast<uint32_t>(header.indexCount);
+            record.indexCount   = static_cast<uint32_t>(mesh.indices.size());
+            record.firstTexture = static_cast<uint32_t>(textures.size());
+            record.textureCount = static_cast<uint32_t>(mesh.textures.size());
+            copyBounds(mesh.bounds, record.boundsMin, record.boundsMax);
+            record.lodCount = static_cast<uint32_t>(std::min<size_t>(mesh.lods.size(), MeshData::MaxLods));
+            for (uint i = 0; i < record.lodCount; ++i)
+            {
+                record.lodIndexCount[i] = mesh.lods[i].indexCount;
+                record.lodError[i]      = mesh.lods[i].error;
+            }
+            records.push_back(record);
+
+            for (const auto& texture : mesh.textures)
+            {
+                TextureRecord textureRecord{};
+                addString(texture.type, textureRecord.typeOffset, textureRecord.typeLength);
+                addString(texture.path, textureRecord.pathOffset, textureRecord.pathLength);
+                textures.push_back(textureRecord);
+            }
+            header.vertexCount += mesh.vertexCount;
+            header.indexCount += mesh.indices.size();
+            bounds.add(mesh.bounds);
+            if (mesh.vertexCount > 65536)
+            {
+                header.indexSize = 4;
+            }
+        }
+        header.textureCount   = static_cast<uint32_t>(textures.size());
+        header.stringsSize    = static_cast<uint32_t>(strings.size());
+        header.stringsOffset  = alignUp(sizeof(Header) + records.size() * sizeof(MeshRecord) +
+                                       textures.size() * sizeof(TextureRecord));
+        header.verticesOffset = alignUp(header.stringsOffset + strings.size());
+        header.indicesOffset  = alignUp(header.verticesOffset + header.vertexCount * header.vertexStride);
+        copyBounds(bounds, header.boundsMin, header.boundsMax);
+
+        // written to a temporary name and renamed, a crash never leaves a truncated file that looks valid
+        auto          temporary = path + ".tmp";
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            std::cout << "ERROR::COOKED_MODEL:: cannot write " << path << std::endl;
+            return false;
+        }
+        auto pad = [&]() {
+            static const char zeros[16] = {};
+            file.write(zeros, alignUp(file.tellp()) - static_cast<uint64_t>(file.tellp()));
+        };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(MeshRecord));
+        file.write(reinterpret_cast<const char*>(textures.data()), textures.size() * sizeof(TextureRecord));
+        pad();
+        file.write(strings.data(), strings.size());
+        pad();
+        for (const auto& mesh : meshes)
+        {
+            file.write(reinterpret_cast<const char*>(mesh.vertices.data()), mesh.vertices.size_bytes());
+        }
+        pad();
+        for (const auto& mesh : meshes)
+        {
+            if (header.indexSize == 4)
+            {
+                file.write(reinterpret_cast<const char*>(mesh.indices.data()), mesh.indices.size_bytes());
+                continue;
+            }
+            std::vector<uint16_t> narrow(mesh.indices.begin(), mesh.indices.end());
+            file.write(reinterpret_cast<const char*>(narrow.data()), narrow.size() * sizeof(uint16_t));
+        }
+        file.close();
+        if (!file)
+        {
+            std::cout << "ERROR::COOKED_MODEL:: failed writing " << path << std::endl;
+            return false;
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        return !error;
+    }
+
+    SPCookedModel CookedModel::open(const std::string& path, const std::string& sourcePath)
+    {
+        auto file = MappedFile::open(path);
+        if (!file)
+        {
+            return nullptr;
+        }
+        uint64_t sourceSize = 0;
+        int64_t  sourceTime = 0;
+        sourceStamp(sourcePath, sourceSize, sourceTime);
+
+        SPCookedModel model(new CookedModel(file));
+        return model->validate(sourceSize, sourceTime) ? model : nullptr;
+    }
+
+    uint CookedModel::getMeshCount() const
+    {
+        return _header->meshCount;
+    }
+
+    uint CookedModel::getVertexCount() const
+    {
+        return static_cast<uint>(_header->vertexCount);
+    }
+
+    MeshData::VertexFormat::format_t CookedModel::getVertexFormat() const
+    {
+        return static_cast<MeshData::VertexFormat::format_t>(_header->vertexFormat);
+    }
+
+    MeshData::ImportOptions CookedModel::getImportOptions() const
+    {
+        MeshData::ImportOptions options;
+        options.vertexFormat = getVertexFormat();
+        options.lodCount     = _header->lodCount;
+        options.lodError     = _header->lodError;
+        return options;
+    }
+
+    uint CookedModel::getIndexCount() const
+    {
+        return static_cast<uint>(_header->indexCount);
+    }
+
+    Type::type_t CookedModel::getIndexType() const
+    {
+        return _header->indexSize == 2 ? Type::UnsignedShort : Type::UnsignedInt;
+    }
+
+    const MeshData::Bounds& CookedModel::getBounds() const
+    {
+        return _bounds;
+    }
+
+    CookedModel::CookedMesh CookedModel::getMesh(uint index) const
+    {
+        const auto& record   = _meshes[index];
+        auto        vertices = _file->at<unsigned char>(_header->verticesOffset);
+        auto        stride   = _header->vertexStride;
+
+        CookedMesh mesh;
+        mesh.vertices    = std::span<const unsigned char>(vertices + size_t(record.firstVertex) * stride,
+                                                          size_t(record.vertexCount) * stride);
+        mesh.vertexCount = record.vertexCount;
+        if (_header->indexSize == 2)
+        {
+            auto indices      = _file->at<uint16_t>(_header->indicesOffset, _header->indexCount);
+            mesh.shortIndices = std::span<const uint16_t>(indices + record.firstIndex, record.indexCount);
+        }
+        else
+        {
+            auto indices = _file->at<unsigned int>(_header->indicesOffset, _header->indexCount);
+            mesh.indices = std::span<const unsigned int>(indices + record.firstIndex, record.indexCount);
+        }
+        mesh.bounds = toBounds(record.boundsMin, record.boundsMax);
+
+        uint firstIndex = 0;
+        for (uint i = 0; i < record.lodCount; ++i)
+        {
+            mesh.lods.push_back({firstIndex, record.lodIndexCount[i], record.lodError[i]});
+            firstIndex += record.lodIndexCount[i];
+        }
+        for (uint i = 0; i < record.textureCount; ++i)
+        {
+            const auto&       texture = _textures[record.firstTexture + i];
+            MeshData::Texture result;
+            result.type = std::string(_strings + texture.typeOffset, texture.typeLength);
+            result.path = std::string(_strings + texture.pathOffset, texture.pathLength);
+            mesh.textures.push_back(result);
+        }
+        return mesh;
+    }
+
+    CookedModel::CookedModel(SPMappedFile file) : _file(file) {}
+
+    bool CookedModel::validate(uint64_t sourceSize, int64_t sourceTime)
+    {
+        _header = _file->at<Header>(0);
+        if (!_header || _header->magic != CookedMagic || _header->version != Version ||
+            _header->vertexFormat >= MeshData::VertexFormat::Count ||
+            _header->vertexStride != MeshData::layoutOf(getVertexFormat()).getStride() ||
+            (_header->indexSize != 2 && _header->indexSize != 4))
+        {
+            return false;
+        }
+        // stale when the source exists and differs from the one the file was cooked from
+        if (sourceSize != 0 && (sourceSize != _header->sourceSize || sourceTime != _header->sourceTime))
+        {
+            return false;
+        }
+
+        _meshes   = _file->at<MeshRecord>(sizeof(Header), _header->meshCount);
+        _textures = _file->at<TextureRecord>(sizeof(Header) + _header->meshCount * sizeof(MeshRecord),
+                                             _header->textureCount);
+        _strings  = _file->at<char>(_header->stringsOffset, _header->stringsSize);
+        if (!_meshes || !_textures || !_strings ||
+            !_file->at<char>(_header->verticesOffset, _header->vertexCount * _header->vertexStride) ||
+            !_file->at<char>(_header->indicesOffset, _header->indexCount * _header->indexSize))
+        {
+            return false;
+        }
+
+        // every range has to stay inside its section, getMesh does not check again
+        for (uint i = 0; i < _header->meshCount; ++i)
+        {
+            const auto& record = _meshes[i];
+            if (uint64_t(record.firstVertex) + record.vertexCount > _header->vertexCount ||
+                uint64_t(record.firstIndex) + record.indexCount > _header->indexCount ||
+                uint64_t(record.firstTexture) + record.textureCount > _header->textureCount ||
+                record.lodCount > MeshData::MaxLods)
+            {
+                return false;
+            }
+            uint64_t lodIndices = 0;
+            for (uint j = 0; j < record.lodCount; ++j)
+            {
+                lodIndices += record.lodIndexCount[j];
+            }
+            if (lodIndices > record.indexCount)
+            {
+                return false;
+            }
+        }
+        for (uint i = 0; i < _header->textureCount; ++i)
+        {
+            const auto& texture = _textures[i];
+            if (uint64_t(texture.typeOffset) + texture.typeLength > _header->stringsSize ||
+                uint64_t(texture.pathOffset) + texture.pathLength > _header->stringsSize)
+            {
+                return false;
+            }
+        }
+        _bounds = toBounds(_header->boundsMin, _header->boundsMax);
+        return true;
+    }
+} // namespace Hub
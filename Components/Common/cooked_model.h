@@ -0,0 +1,87 @@
+#pragma once
+#include "utils.h"
+#include "mesh.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Hub
+{
+    class CookedModel;
+    using SPCookedModel = std::shared_ptr<CookedModel>;
+
+    // .hubmesh, a Model cooked for loading without Assimp. The file is mapped and the streams are uploaded
+    // from the mapped pages as they are. Layout, every section 16 byte aligned:
+    //   Header
+    //   MeshRecord[meshCount]         ranges, bounds and levels of detail of each mesh
+    //   TextureRecord[textureCount]   type and path of each texture, both in the string table
+    //   string table
+    //   vertices                      in the MeshData::VertexFormat the model was imported with, the meshes back
+    //                                 to back
+    //   indices                       relative to the first vertex of their mesh, uint16 when every mesh has at
+    //                                 most 65536 vertices, otherwise uint32
+    // The header stores the size and write time of the source file, a cooked file whose source changed since
+    // is stale and ignored.
+    class CookedModel
+    {
+    public:
+        // 2: meshes are optimized at import, indices may be 16 bit
+        // 3: vertex format and levels of detail
+        static constexpr uint32_t Version = 3;
+
+        struct CookedMesh
+        {
+            std::span<const unsigned char> vertices; // vertexCount vertices of the file's vertex format
+            uint                           vertexCount = 0;
+            // write reads indices, getMesh fills the one matching getIndexType() and leaves the other empty
+            std::span<const unsigned int>  indices;
+            std::span<const uint16_t>      shortIndices;
+            MeshData::Bounds               bounds;   // Quantized positions are relative to it
+            std::vector<MeshData::Lod>     lods;     // ranges of indices, at most MeshData::MaxLods
+            std::vector<MeshData::Texture> textures; // type and path, ptr is not stored
+        };
+
+        // "backpack.obj" -> "backpack.obj.hubmesh", next to the source
+        static std::string pathFor(const std::string& sourcePath);
+
+        // options are the ones the meshes were imported with
+        static bool write(const std::string&             path,
+                          const std::string&             sourcePath,
+                          const MeshData::ImportOptions& options,
+                          const std::vector<CookedMesh>& meshes);
+
+        // nullptr when the file is missing, malformed, of another version or older than its source. A missing
+        // source is fine, the cooked file can ship on its own.
+        static SPCookedModel open(const std::string& path, const std::string& sourcePath);
+
+        uint                             getMeshCount() const;
+        uint                             getVertexCount() const;
+        MeshData::VertexFormat::format_t getVertexFormat() const;
+        MeshData::ImportOptions          getImportOptions() const;
+        uint                             getIndexCount() const;
+        Type::type_t                     getIndexType() const;
+        const MeshData::Bounds&          getBounds() const;
+
+        // spans point into the mapping and stay valid while the CookedModel lives
+        CookedMesh getMesh(uint index) const;
+
+    private:
+        struct Header;
+        struct MeshRecord;
+        struct TextureRecord;
+
+        CookedModel(SPMappedFile file);
+
+        bool validate(uint64_t sourceSize, int64_t sourceTime);
+
+        SPMappedFile         _file;
+        const Header*        _header   = nullptr;
+        const MeshRecord*    _meshes   = nullptr;
+        const TextureRecord* _textures = nullptr;
+        const char*          _strings  = nullptr;
+        MeshData::Bounds     _bounds;
+    };
+} // namespace Hub
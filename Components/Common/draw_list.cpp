@@ -0,0 +1,162 @@
+#include "draw_list.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Hub
+{
+    namespace
+    {
+        const uint ProgramBits  = 10;
+        const uint MaterialBits = 14;
+        const uint GeometryBits = 10;
+        const uint DepthBits    = 24;
+
+        uint64_t field(uint value, uint bits)
+        {
+            // ids past the field share its last value, which only costs sort quality
+            return std::min<uint64_t>(value, (1ull << bits) - 1);
+        }
+
+        // the bits of a non-negative float order like the float, the top ones are a coarse depth
+        uint64_t depthOf(float distance)
+        {
+            uint32_t bits = 0;
+            distance      = std::max(distance, 0.f);
+            std::memcpy(&bits, &distance, sizeof(bits));
+            return bits >> (32 - DepthBits);
+        }
+    } // namespace
+
+    SPDrawList DrawList::create()
+    {
+        return SPDrawList(new DrawList());
+    }
+
+    void DrawList::begin(const Vector3& eye)
+    {
+        _eye = eye;
+        _items.clear();
+        _keys.clear();
+        _programIds.clear();
+        _materialIds.clear();
+        _geometryIds.clear();
+    }
+
+    void DrawList::add(Shader& shader, Mesh& mesh, const Matrix4& transform, uint lod, bool transparent)
+    {
+        Vector3 center(0.f); // the mesh origin when it has no bounds
+        if (mesh.bounds.min.x <= mesh.bounds.max.x)
+        {
+            center = (mesh.bounds.min + mesh.bounds.max) * 0.5f;
+        }
+        float distance = glm::length(Vector3(transform * Vector4(center, 1.f)) - _eye);
+
+        uint64_t program  = field(idOf<const Shader*>(_programIds, &shader), ProgramBits);
+        uint64_t material = field(idOf<uint64_t>(_materialIds, mesh.getMaterial()->getHash()), MaterialBits);
+        uint64_t geometry = field(idOf<const void*>(_geometryIds, mesh.getGeometryKey()), GeometryBits);
+        uint64_t depth    = depthOf(distance);
+
+        uint64_t key = 0;
+        if (transparent)
+        {
+            uint64_t farFirst = ((1ull << DepthBits) - 1) - depth;
+            key               = 1ull << 63;
+            key |= farFirst << (ProgramBits + MaterialBits + GeometryBits);
+            key |= program << (MaterialBits + GeometryBits);
+            key |= material << GeometryBits;
+            key |= geometry;
+        }
+        else
+        {
+            key = program << (MaterialBits + GeometryBits + DepthBits);
+            key |= material << (GeometryBits + DepthBits);
+            key |= geometry << DepthBits;
+            key |= depth;
+        }
+
+        _keys.emplace_back(key, static_cast<uint>(_items.size()));
+        _items.push_back({&shader, &mesh, transform, lod, transparent});
+    }
+
+    void DrawList::submit()
+    {
+        std::sort(_keys.begin(), _keys.end());
+
+        _stats                 = Stats();
+        _stats.items           = static_cast<uint>(_items.size());
+        Shader*       shader   = nullptr;
+        UniformHandle model;
+        uint64_t      material = 0;
+        const void*   geometry = nullptr;
+        bool          blending = false;
+
+        // blend and depth write state of the caller, restored after the transparent items
+        GLboolean blendEnabled = GL_FALSE;
+        GLboolean depthMask    = GL_TRUE;
+        GLint     blendFunc[4] = {GL_ONE, GL_ZERO, GL_ONE, GL_ZERO};
+        for (const auto& [key, index] : _keys)
+        {
+            const auto& item = _items[index];
+            if (item.transparent && !blending)
+            {
+                blendEnabled = glIsEnabled(GL_BLEND);
+                glGetBooleanv(GL_DEPTH_WRITEMASK, &depthMask);
+                glGetIntegerv(GL_BLEND_SRC_RGB, &blendFunc[0]);
+                glGetIntegerv(GL_BLEND_DST_RGB, &blendFunc[1]);
+                glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendFunc[2]);
+                glGetIntegerv(GL_BLEND_DST_ALPHA, &blendFunc[3]);
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                glDepthMask(GL_FALSE);
+                blending = true;
+            }
+            if (item.shader != shader)
+            {
+                // resolved on every switch, an async build may have finished since the last one
+                shader = item.shader;
+                shader->use();
+                model = shader->getUniform("model");
+                ++_stats.programs;
+            }
+            uint64_t hash = item.mesh->getMaterial()->getHash();
+            if (_stats.materials == 0 || hash != material)
+            {
+                material = hash;
+                ++_stats.materials;
+            }
+            if (item.mesh->getGeometryKey() != geometry)
+            {
+                geometry = item.mesh->getGeometryKey();
+                ++_stats.geometries;
+            }
+
+            shader->setMatirx4(model, item.transform);
+            item.mesh->draw(*shader, item.lod);
+        }
+        if (blending)
+        {
+            glDepthMask(depthMask);
+            glBlendFuncSeparate(blendFunc[0], blendFunc[1], blendFunc[2], blendFunc[3]);
+            if (!blendEnabled)
+            {
+                glDisable(GL_BLEND);
+            }
+        }
+    }
+
+    uint DrawList::getItemCount() const
+    {
+        return static_cast<uint>(_items.size());
+    }
+
+    const DrawList::Stats& DrawList::getStats() const
+    {
+        return _stats;
+    }
+
+    template <typename Key>
+    uint DrawList::idOf(std::unordered_map<Key, uint>& ids, const Key& key)
+    {
+        return ids.emplace(key, static_cast<uint>(ids.size())).first->second;
+    }
+} // namespace Hub
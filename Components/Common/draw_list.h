@@ -0,0 +1,74 @@
+#pragma once
+#include "utils.h"
+#include "gmath.h"
+#include "shader.h"
+#include "mesh.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Hub
+{
+    class DrawList;
+    using SPDrawList = std::shared_ptr<DrawList>;
+
+    // Collects the draws of a frame across models and submits them sorted by a 64-bit key:
+    //   opaque       0 | program | material | geometry | depth     grouped by state, front to back within a group
+    //   transparent  1 | ~depth  | program | material | geometry   back to front
+    // Submission only switches the program when it changes, Material and GLState skip the texture and buffer
+    // binds that are already in place. Typical frame: begin() -> add()... -> submit()
+    class DrawList
+    {
+    public:
+        // state changes made by the last submit
+        struct Stats
+        {
+            uint items      = 0;
+            uint programs   = 0;
+            uint materials  = 0;
+            uint geometries = 0;
+        };
+
+        static SPDrawList create();
+
+        // drops the items of the last frame, depths are measured from eye
+        void begin(const Vector3& eye);
+
+        // transform goes to the mat4 uniform "model" of shader. Both must outlive the submit, the other uniforms
+        // of shader are set by the caller beforehand.
+        void add(Shader& shader, Mesh& mesh, const Matrix4& transform, uint lod = 0, bool transparent = false);
+
+        // draws opaque items first, then transparent ones with alpha blending and without depth writes. The blend
+        // and depth write state set before is restored afterwards.
+        void submit();
+
+        uint         getItemCount() const;
+        const Stats& getStats() const;
+
+    private:
+        struct Item
+        {
+            Shader* shader;
+            Mesh*   mesh;
+            Matrix4 transform;
+            uint    lod;
+            bool    transparent;
+        };
+
+        DrawList() = default;
+
+        // small dense ids in order of first appearance, they fill the state fields of the key
+        template <typename Key>
+        static uint idOf(std::unordered_map<Key, uint>& ids, const Key& key);
+
+        std::vector<Item>                       _items;
+        std::vector<std::pair<uint64_t, uint>>  _keys; // key, index in _items
+        std::unordered_map<const Shader*, uint> _programIds;
+        std::unordered_map<uint64_t, uint>      _materialIds;
+        std::unordered_map<const void*, uint>   _geometryIds;
+        Vector3                                 _eye = Vector3(0.f);
+        Stats                                   _stats;
+    };
+} // namespace Hub
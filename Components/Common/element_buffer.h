@@ -17,6 +17,8 @@ namespace Hub
         ~ElementBuffer();
 
     private:
+        template <typename>
+        friend class HandlePool;
         ElementBuffer();
         ElementBuffer(const void* data, size_t length, BufferUsage::buffer_usage_t usage);
     };
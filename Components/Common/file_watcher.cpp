@@ -0,0 +1,150 @@
+#include "file_watcher.h"
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Hub
+{
+    namespace
+    {
+        std::filesystem::file_time_type lastWriteTime(const std::string& path)
+        {
+            std::error_code error;
+            auto            time = std::filesystem::last_write_time(path, error);
+            return error ? std::filesystem::file_time_type::min() : time;
+        }
+
+        std::string parentOf(const std::string& path)
+        {
+            return std::filesystem::path(path).parent_path().string();
+        }
+    } // namespace
+
+    SPFileWatcher FileWatcher::create()
+    {
+        return SPFileWatcher(new FileWatcher());
+    }
+
+    FileWatcher::~FileWatcher()
+    {
+#ifdef __linux__
+        if (_inotify >= 0)
+        {
+            close(_inotify);
+        }
+#endif
+    }
+
+    void FileWatcher::watch(const std::string& path)
+    {
+        std::string file = normalize(path);
+        if (_files.count(file))
+        {
+            return;
+        }
+        _files[file] = lastWriteTime(file);
+
+#ifdef __linux__
+        std::string directory = parentOf(file);
+        if (_inotify >= 0 && _directoryRefs[directory]++ == 0)
+        {
+            int wd = inotify_add_watch(_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+            if (wd >= 0)
+            {
+                _directories[wd] = directory;
+            }
+            else
+            {
+                std::cout << "ERROR::FILE_WATCHER:: cannot watch " << directory << std::endl;
+            }
+        }
+#endif
+    }
+
+    void FileWatcher::unwatch(const std::string& path)
+    {
+        std::string file = normalize(path);
+        if (_files.erase(file) == 0)
+        {
+            return;
+        }
+
+#ifdef __linux__
+        std::string directory = parentOf(file);
+        if (_inotify >= 0 && --_directoryRefs[directory] == 0)
+        {
+            _directoryRefs.erase(directory);
+            for (auto it = _directories.begin(); it != _directories.end(); ++it)
+            {
+                if (it->second == directory)
+                {
+                    inotify_rm_watch(_inotify, it->first);
+                    _directories.erase(it);
+                    break;
+                }
+            }
+        }
+#endif
+    }
+
+    std::vector<std::string> FileWatcher::poll()
+    {
+        std::vector<std::string> changed;
+
+#ifdef __linux__
+        if (_inotify >= 0)
+        {
+            alignas(inotify_event) char buffer[4096];
+            ssize_t length = 0;
+            while ((length = read(_inotify, buffer, sizeof(buffer))) > 0)
+            {
+                for (char* p = buffer; p < buffer + length;)
+                {
+                    auto event = reinterpret_cast<const inotify_event*>(p);
+                    auto it    = _directories.find(event->wd);
+                    if (it != _directories.end() && event->len > 0)
+                    {
+                        std::string file = (std::filesystem::path(it->second) / event->name).string();
+                        if (_files.count(file) && std::find(changed.begin(), changed.end(), file) == changed.end())
+                        {
+                            changed.push_back(file);
+                        }
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+            return changed;
+        }
+#endif
+
+        for (auto& [file, time] : _files)
+        {
+            auto current = lastWriteTime(file);
+            if (current != time)
+            {
+                time = current;
+                changed.push_back(file);
+            }
+        }
+        return changed;
+    }
+
+    std::string FileWatcher::normalize(const std::string& path)
+    {
+        return std::filesystem::absolute(path).lexically_normal().string();
+    }
+
+    FileWatcher::FileWatcher()
+    {
+#ifdef __linux__
+        _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (_inotify < 0)
+        {
+            std::cout << "ERROR::FILE_WATCHER:: inotify unavailable, falling back to polling" << std::endl;
+        }
+#endif
+    }
+} // namespace Hub
@@ -0,0 +1,42 @@
+#pragma once
+#include "utils.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Hub
+{
+    class FileWatcher;
+    using SPFileWatcher = std::shared_ptr<FileWatcher>;
+
+    // Reports files that changed on disk. Linux uses inotify on the parent directories, which also catches
+    // editors that save by writing a new file and renaming it over the old one. Elsewhere the modification
+    // times are compared on every poll, which is fine for the few dozen files a demo watches.
+    class FileWatcher
+    {
+    public:
+        static SPFileWatcher create();
+        ~FileWatcher();
+
+        void watch(const std::string& path);
+        void unwatch(const std::string& path);
+
+        // files changed since the last poll, as normalized paths, never blocks
+        std::vector<std::string> poll();
+
+        // absolute and lexically normal, the form paths are reported in
+        static std::string normalize(const std::string& path);
+
+    private:
+        FileWatcher();
+
+        std::unordered_map<std::string, std::filesystem::file_time_type> _files; // watched path -> last write
+#ifdef __linux__
+        int                                   _inotify = -1;
+        std::unordered_map<int, std::string>  _directories; // watch descriptor -> directory
+        std::unordered_map<std::string, uint> _directoryRefs;
+#endif
+    };
+} // namespace Hub
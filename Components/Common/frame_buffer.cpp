@@ -1,4 +1,6 @@
 #include "frame_buffer.h"
+#include "gl_extensions.h"
+#include "gl_deletion_queue.h"
 
 namespace Hub
 {
@@ -9,7 +11,7 @@ namespace Hub
 
     FrameBuffer::~FrameBuffer()
     {
-        glDeleteBuffers(1, &_obj);
+        GLDeletionQueue::release(GLObject::FrameBuffer, _obj);
     }
 
     FrameBuffer::operator GLuint() const
@@ -17,9 +19,86 @@ namespace Hub
         return _obj;
     }
 
-    FrameBuffer::FrameBuffer()
+    void FrameBuffer::bind(GLenum target) const
     {
-        glGenFramebuffers(1, &_obj);
+        glBindFramebuffer(target, _obj);
     }
 
-} // namespace Hub
\ No newline at end of file
+    // without dsa the framebuffer is bound for the edit and the default framebuffer restored afterwards
+    void FrameBuffer::attachTexture(GLenum attachment, const Texture& texture, int level)
+    {
+        if (_dsa)
+        {
+            glNamedFramebufferTexture(_obj, attachment, texture, level);
+            return;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, _obj);
+        glFramebufferTexture(GL_FRAMEBUFFER, attachment, texture, level);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    void FrameBuffer::attachRenderBuffer(GLenum attachment, const RenderBuffer& renderBuffer)
+    {
+        if (_dsa)
+        {
+            glNamedFramebufferRenderbuffer(_obj, attachment, GL_RENDERBUFFER, renderBuffer);
+            return;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, _obj);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, renderBuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    void FrameBuffer::setDrawBuffer(GLenum buffer)
+    {
+        if (_dsa)
+        {
+            glNamedFramebufferDrawBuffer(_obj, buffer);
+            return;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, _obj);
+        glDrawBuffer(buffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    void FrameBuffer::setReadBuffer(GLenum buffer)
+    {
+        if (_dsa)
+        {
+            glNamedFramebufferReadBuffer(_obj, buffer);
+            return;
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, _obj);
+        glReadBuffer(buffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    bool FrameBuffer::isComplete()
+    {
+        GLenum status;
+        if (_dsa)
+        {
+            status = glCheckNamedFramebufferStatus(_obj, GL_FRAMEBUFFER);
+        }
+        else
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, _obj);
+            status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        }
+        return status == GL_FRAMEBUFFER_COMPLETE;
+    }
+
+    FrameBuffer::FrameBuffer() : _dsa(GLExtensions::get().directStateAccess)
+    {
+        if (_dsa)
+        {
+            glCreateFramebuffers(1, &_obj);
+        }
+        else
+        {
+            glGenFramebuffers(1, &_obj);
+        }
+    }
+
+} // namespace Hub
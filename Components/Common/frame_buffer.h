@@ -1,5 +1,8 @@
 #pragma once
 #include "utils.h"
+#include "texture.h"
+#include "render_buffer.h"
+#include <memory>
 
 namespace Hub
 {
@@ -13,8 +16,18 @@ namespace Hub
         ~FrameBuffer();
         operator GLuint() const;
 
+        void bind(GLenum target = GL_FRAMEBUFFER) const;
+        void attachTexture(GLenum attachment, const Texture& texture, int level = 0);
+        void attachRenderBuffer(GLenum attachment, const RenderBuffer& renderBuffer);
+        void setDrawBuffer(GLenum buffer);
+        void setReadBuffer(GLenum buffer);
+        bool isComplete();
+
     private:
+        template <typename>
+        friend class HandlePool;
         FrameBuffer();
         GLuint _obj;
+        bool   _dsa;
     };
-} // namespace Hub
\ No newline at end of file
+} // namespace Hub
@@ -0,0 +1,279 @@
+#include "frame_graph.h"
+
+namespace Hub
+{
+    FrameGraph::Resource FrameGraph::Builder::create(const std::string& name, const RenderTargetDesc& desc)
+    {
+        Resource resource = static_cast<Resource>(_graph._resources.size());
+
+        ResourceNode node;
+        node.name     = name;
+        node.desc     = desc;
+        node.producer = _pass;
+        _graph._resources.push_back(node);
+        _graph._passes[_pass].creates.push_back(resource);
+        return resource;
+    }
+
+    void FrameGraph::Builder::read(Resource resource)
+    {
+        _graph._passes[_pass].reads.push_back(resource);
+        if (resource < _graph._resources.size())
+        {
+            _graph._resources[resource].readers.push_back(_pass);
+        }
+    }
+
+    void FrameGraph::Builder::writeBackBuffer()
+    {
+        _graph._passes[_pass].backBuffer = true;
+    }
+
+    FrameGraph::Builder::Builder(FrameGraph& graph, uint pass) : _graph(graph), _pass(pass) {}
+
+    const SPRenderTarget& FrameGraph::Context::getTarget(Resource resource) const
+    {
+        return _graph._resources[resource].target;
+    }
+
+    Texture* FrameGraph::Context::getTexture(Resource resource) const
+    {
+        const auto& node = _graph._resources[resource];
+        return node.resolved ? node.resolved->colorTexture : node.target->colorTexture;
+    }
+
+    Texture* FrameGraph::Context::getDepthTexture(Resource resource) const
+    {
+        return _graph._resources[resource].target->depthTexture;
+    }
+
+    FrameGraph::Context::Context(const FrameGraph& graph) : _graph(graph) {}
+
+    SPFrameGraph FrameGraph::create(SPRenderTargetPool pool)
+    {
+        return SPFrameGraph(new FrameGraph(pool));
+    }
+
+    void FrameGraph::addPass(const std::string& name, const Setup& setup, const Execute& execute)
+    {
+        PassNode pass;
+        pass.name    = name;
+        pass.execute = execute;
+        _passes.push_back(pass);
+        _compiled = false;
+
+        Builder builder(*this, static_cast<uint>(_passes.size() - 1));
+        setup(builder);
+    }
+
+    void FrameGraph::setBackBufferSize(int width, int height)
+    {
+        _backBufferWidth  = width;
+        _backBufferHeight = height;
+    }
+
+    bool FrameGraph::compile()
+    {
+        _order.clear();
+        _compiled = false;
+
+        for (uint i = 0; i < _passes.size(); ++i)
+        {
+            auto& pass = _passes[i];
+            if (pass.creates.size() + (pass.backBuffer ? 1 : 0) > 1)
+            {
+                std::cout << "ERROR::FRAME_GRAPH:: pass " << pass.name << " has more than one output" << std::endl;
+                return false;
+            }
+            for (Resource resource : pass.reads)
+            {
+                if (resource >= _resources.size() || _resources[resource].producer >= i)
+                {
+                    std::cout << "ERROR::FRAME_GRAPH:: pass " << pass.name << " reads a target no earlier pass creates"
+                              << std::endl;
+                    return false;
+                }
+            }
+            pass.refCount = static_cast<uint>(pass.creates.size());
+            pass.culled   = false;
+        }
+
+        // cull: walk back from the targets nobody reads, a producer whose outputs are all unread goes too and
+        // its inputs lose a reader. Back buffer passes are the roots and are never culled.
+        std::vector<Resource> unread;
+        for (uint i = 0; i < _resources.size(); ++i)
+        {
+            _resources[i].refCount = static_cast<uint>(_resources[i].readers.size());
+            if (_resources[i].refCount == 0)
+            {
+                unread.push_back(i);
+            }
+        }
+        auto cull = [&](PassNode& pass) {
+            pass.culled = true;
+            for (Resource resource : pass.reads)
+            {
+                if (--_resources[resource].refCount == 0)
+                {
+                    unread.push_back(resource);
+                }
+            }
+        };
+        for (auto& pass : _passes)
+        {
+            if (pass.refCount == 0 && !pass.backBuffer)
+            {
+                cull(pass);
+            }
+        }
+        while (!unread.empty())
+        {
+            auto& producer = _passes[_resources[unread.back()].producer];
+            unread.pop_back();
+            if (--producer.refCount == 0 && !producer.backBuffer)
+            {
+                cull(producer);
+            }
+        }
+
+        // lifetimes, a target is released after the last pass that touches it
+        for (uint i = 0; i < _passes.size(); ++i)
+        {
+            const auto& pass = _passes[i];
+            if (pass.culled)
+            {
+                continue;
+            }
+            uint position = static_cast<uint>(_order.size());
+            _order.push_back(i);
+            for (Resource resource : pass.creates)
+            {
+                _resources[resource].lastUse = position;
+            }
+            for (Resource resource : pass.reads)
+            {
+                _resources[resource].lastUse = position;
+            }
+        }
+
+        _compiled = true;
+        return true;
+    }
+
+    void FrameGraph::execute()
+    {
+        if (!_compiled && !compile())
+        {
+            return;
+        }
+
+        _pool->setViewportSize(_backBufferWidth, _backBufferHeight);
+        Context context(*this);
+        for (uint position = 0; position < _order.size(); ++position)
+        {
+            auto& pass = _passes[_order[position]];
+            for (Resource resource : pass.creates)
+            {
+                _resources[resource].target = _pool->acquire(_resources[resource].desc);
+            }
+
+            bindOutput(pass);
+            pass.execute(context);
+
+            // refCount is the number of readers left after culling
+            for (Resource resource : pass.creates)
+            {
+                auto& node = _resources[resource];
+                if (node.desc.samples > 0 && node.desc.color && node.refCount > 0)
+                {
+                    resolve(node);
+                }
+            }
+
+            // the pool hands released targets to the passes after this one, which is where aliasing happens
+            auto releaseIfDone = [&](Resource resource) {
+                auto& node = _resources[resource];
+                if (node.lastUse != position || !node.target)
+                {
+                    return;
+                }
+                _pool->release(node.target);
+                node.target = nullptr;
+                if (node.resolved)
+                {
+                    _pool->release(node.resolved);
+                    node.resolved = nullptr;
+                }
+            };
+            for (Resource resource : pass.creates)
+            {
+                releaseIfDone(resource);
+            }
+            for (Resource resource : pass.reads)
+            {
+                releaseIfDone(resource);
+            }
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    void FrameGraph::reset()
+    {
+        for (auto& node : _resources)
+        {
+            if (node.target)
+            {
+                _pool->release(node.target);
+            }
+            if (node.resolved)
+            {
+                _pool->release(node.resolved);
+            }
+        }
+        _passes.clear();
+        _resources.clear();
+        _order.clear();
+        _compiled = false;
+    }
+
+    uint FrameGraph::getPassCount() const
+    {
+        return static_cast<uint>(_passes.size());
+    }
+
+    uint FrameGraph::getCulledPassCount() const
+    {
+        return static_cast<uint>(_passes.size() - _order.size());
+    }
+
+    FrameGraph::FrameGraph(SPRenderTargetPool pool) : _pool(pool) {}
+
+    void FrameGraph::bindOutput(const PassNode& pass) const
+    {
+        if (pass.backBuffer)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glViewport(0, 0, _backBufferWidth, _backBufferHeight);
+        }
+        else if (!pass.creates.empty())
+        {
+            const auto& target = _resources[pass.creates.front()].target;
+            target->frameBuffer->bind();
+            glViewport(0, 0, target->desc.width, target->desc.height);
+        }
+    }
+
+    void FrameGraph::resolve(ResourceNode& resource)
+    {
+        RenderTargetDesc desc = resource.target->desc;
+        desc.samples          = 0;
+        desc.depth            = DepthAttachment::None;
+        resource.resolved     = _pool->acquire(desc);
+
+        int width  = desc.width;
+        int height = desc.height;
+        resource.target->frameBuffer->bind(GL_READ_FRAMEBUFFER);
+        resource.resolved->frameBuffer->bind(GL_DRAW_FRAMEBUFFER);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+} // namespace Hub
@@ -0,0 +1,112 @@
+#pragma once
+#include "utils.h"
+#include "render_target_pool.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Hub
+{
+    class FrameGraph;
+    using SPFrameGraph = std::shared_ptr<FrameGraph>;
+
+    // Passes declare the render targets they create and read, the graph works out the rest:
+    //  - passes whose outputs nobody reads are culled, unless they draw to the back buffer
+    //  - passes run in declaration order, a pass can only read targets created by the passes added before it
+    //  - reading a multisampled target inserts a resolve blit, the reader samples the resolved copy
+    //  - transient targets are acquired from the pool right before their first use and released after their
+    //    last one, so targets with the same descriptor and disjoint lifetimes share one FBO
+    // Typical frame: reset() -> addPass()... -> compile() -> execute()
+    class FrameGraph
+    {
+    public:
+        using Resource                            = uint;
+        static constexpr Resource InvalidResource = 0xFFFFFFFF;
+
+        class Builder
+        {
+        public:
+            // a pass renders into the one target it creates, or into the back buffer
+            Resource create(const std::string& name, const RenderTargetDesc& desc);
+            void     read(Resource resource);
+            void     writeBackBuffer();
+
+        private:
+            friend class FrameGraph;
+            Builder(FrameGraph& graph, uint pass);
+
+            FrameGraph& _graph;
+            uint        _pass;
+        };
+
+        class Context
+        {
+        public:
+            // target the pass renders to, bound with its viewport before the pass runs
+            const SPRenderTarget& getTarget(Resource resource) const;
+            // what to sample, the resolved copy for multisampled targets
+            Texture* getTexture(Resource resource) const;
+            Texture* getDepthTexture(Resource resource) const;
+
+        private:
+            friend class FrameGraph;
+            Context(const FrameGraph& graph);
+
+            const FrameGraph& _graph;
+        };
+
+        using Setup   = std::function<void(Builder& builder)>;
+        using Execute = std::function<void(Context& context)>;
+
+        static SPFrameGraph create(SPRenderTargetPool pool);
+
+        void addPass(const std::string& name, const Setup& setup, const Execute& execute);
+        void setBackBufferSize(int width, int height);
+
+        // false when the graph is invalid (a pass with several outputs or reading an unknown target)
+        bool compile();
+        void execute();
+        void reset();
+
+        uint getPassCount() const;
+        uint getCulledPassCount() const;
+
+    private:
+        struct ResourceNode
+        {
+            std::string           name;
+            RenderTargetDesc      desc;
+            uint                  producer = 0;
+            std::vector<uint>     readers;
+            uint                  lastUse  = 0; // position in _order of the last pass touching it
+            uint                  refCount = 0;
+            SPRenderTarget        target;
+            SPRenderTarget        resolved; // single sampled copy of a multisampled target that is read
+        };
+
+        struct PassNode
+        {
+            std::string           name;
+            Execute               execute;
+            std::vector<Resource> creates;
+            std::vector<Resource> reads;
+            bool                  backBuffer = false;
+            uint                  refCount   = 0;
+            bool                  culled     = false;
+        };
+
+        FrameGraph(SPRenderTargetPool pool);
+
+        void bindOutput(const PassNode& pass) const;
+        void resolve(ResourceNode& resource);
+
+        SPRenderTargetPool        _pool;
+        std::vector<PassNode>     _passes;
+        std::vector<ResourceNode> _resources;
+        std::vector<uint>         _order;
+        bool                      _compiled         = false;
+        int                       _backBufferWidth  = 0;
+        int                       _backBufferHeight = 0;
+    };
+} // namespace Hub
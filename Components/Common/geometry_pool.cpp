@@ -0,0 +1,205 @@
+#include "geometry_pool.h"
+#include "vertex_format_cache.h"
+#include <algorithm>
+
+namespace Hub
+{
+    Geometry::~Geometry()
+    {
+        _pool->release(this);
+    }
+
+    uint Geometry::getBaseVertex() const
+    {
+        return _vertices.offset;
+    }
+
+    uint Geometry::getVertexCount() const
+    {
+        return _vertexCount;
+    }
+
+    uint Geometry::getFirstIndex() const
+    {
+        return _indices.offset;
+    }
+
+    uint Geometry::getIndexCount() const
+    {
+        return _indexCount;
+    }
+
+    const SPGeometryPool& Geometry::getPool() const
+    {
+        return _pool;
+    }
+
+    void Geometry::draw(GLenum mode) const
+    {
+        draw(mode, 0, _indexCount);
+    }
+
+    void Geometry::draw(GLenum mode, uint firstIndex, uint indexCount) const
+    {
+        _pool->bind();
+        glDrawElementsBaseVertex(mode,
+                                 indexCount,
+                                 _pool->_indexType,
+                                 (GLvoid*)(size_t(_indices.offset + firstIndex) * _pool->_indexSize),
+                                 _vertices.offset);
+    }
+
+    Geometry::Geometry(SPGeometryPool              pool,
+                       OffsetAllocator::Allocation vertices,
+                       uint                        vertexCount,
+                       OffsetAllocator::Allocation indices,
+                       uint                        indexCount) :
+        _pool(pool),
+        _vertices(vertices),
+        _indices(indices),
+        _vertexCount(vertexCount),
+        _indexCount(indexCount)
+    {}
+
+    SPGeometryPool
+    GeometryPool::create(const VertexLayout& layout, uint vertexCapacity, uint indexCapacity, Type::type_t indexType)
+    {
+        return SPGeometryPool(new GeometryPool(layout, vertexCapacity, indexCapacity, indexType));
+    }
+
+    SPGeometry GeometryPool::allocate(const void* vertices, uint vertexCount, const uint* indices, uint indexCount)
+    {
+        if (_indexType == Type::UnsignedInt)
+        {
+            return upload(vertices, vertexCount, indices, indexCount);
+        }
+        if (vertexCount > 65536)
+        {
+            std::cout << "ERROR::GEOMETRY_POOL:: " << vertexCount << " vertices do not fit 16 bit indices"
+                      << std::endl;
+            return nullptr;
+        }
+        std::vector<uint16_t> narrow(indices, indices + indexCount);
+        return upload(vertices, vertexCount, narrow.data(), indexCount);
+    }
+
+    SPGeometry GeometryPool::allocate(const void* vertices, uint vertexCount, const uint16_t* indices, uint indexCount)
+    {
+        if (_indexType == Type::UnsignedShort)
+        {
+            return upload(vertices, vertexCount, indices, indexCount);
+        }
+        std::vector<uint> wide(indices, indices + indexCount);
+        return upload(vertices, vertexCount, wide.data(), indexCount);
+    }
+
+    void GeometryPool::defragment()
+    {
+        size_t stride        = _layout.getStride();
+        auto   vertexBuffer  = VertexBuffer::create(nullptr, getVertexCapacity() * stride, BufferUsage::StaticDraw);
+        auto   elementBuffer = ElementBuffer::create(nullptr, getIndexCapacity() * _indexSize, BufferUsage::StaticDraw);
+
+        // keep the relative order so the copies stay sequential
+        std::sort(_live.begin(), _live.end(), [](const Geometry* a, const Geometry* b) {
+            return a->_vertices.offset < b->_vertices.offset;
+        });
+        _vertexAllocator.reset();
+        _indexAllocator.reset();
+        for (auto geometry : _live)
+        {
+            auto vertexRange = _vertexAllocator.allocate(geometry->_vertexCount);
+            auto indexRange  = _indexAllocator.allocate(geometry->_indexCount);
+            vertexBuffer->copySubData(*_vertexBuffer,
+                                      geometry->_vertices.offset * stride,
+                                      vertexRange.offset * stride,
+                                      geometry->_vertexCount * stride);
+            elementBuffer->copySubData(*_elementBuffer,
+                                       geometry->_indices.offset * _indexSize,
+                                       indexRange.offset * _indexSize,
+                                       geometry->_indexCount * _indexSize);
+            geometry->_vertices = vertexRange;
+            geometry->_indices  = indexRange;
+        }
+        _vertexBuffer  = vertexBuffer;
+        _elementBuffer = elementBuffer;
+    }
+
+    void GeometryPool::bind() const
+    {
+        VertexFormatCache::bind(_layout, *_vertexBuffer, _elementBuffer.get());
+    }
+
+    const VertexLayout& GeometryPool::getLayout() const
+    {
+        return _layout;
+    }
+
+    Type::type_t GeometryPool::getIndexType() const
+    {
+        return _indexType;
+    }
+
+    uint GeometryPool::getVertexCapacity() const
+    {
+        return _vertexAllocator.getSize();
+    }
+
+    uint GeometryPool::getIndexCapacity() const
+    {
+        return _indexAllocator.getSize();
+    }
+
+    uint GeometryPool::getFreeVertices() const
+    {
+        return _vertexAllocator.getReport().totalFree;
+    }
+
+    uint GeometryPool::getFreeIndices() const
+    {
+        return _indexAllocator.getReport().totalFree;
+    }
+
+    GeometryPool::GeometryPool(const VertexLayout& layout,
+                               uint                vertexCapacity,
+                               uint                indexCapacity,
+                               Type::type_t        indexType) :
+        _layout(layout),
+        _indexType(indexType),
+        _indexSize(Type::sizeOf(indexType)),
+        _vertexAllocator(vertexCapacity),
+        _indexAllocator(indexCapacity)
+    {
+        _vertexBuffer =
+            VertexBuffer::create(nullptr, size_t(vertexCapacity) * layout.getStride(), BufferUsage::StaticDraw);
+        _elementBuffer = ElementBuffer::create(nullptr, size_t(indexCapacity) * _indexSize, BufferUsage::StaticDraw);
+    }
+
+    SPGeometry GeometryPool::upload(const void* vertices, uint vertexCount, const void* indices, uint indexCount)
+    {
+        auto vertexRange = _vertexAllocator.allocate(vertexCount);
+        auto indexRange  = _indexAllocator.allocate(indexCount);
+        if (!vertexRange.isValid() || !indexRange.isValid())
+        {
+            _vertexAllocator.free(vertexRange);
+            _indexAllocator.free(indexRange);
+            std::cout << "ERROR::GEOMETRY_POOL:: out of space for " << vertexCount << " vertices, " << indexCount
+                      << " indices" << std::endl;
+            return nullptr;
+        }
+
+        size_t stride = _layout.getStride();
+        _vertexBuffer->subData(vertices, vertexRange.offset * stride, vertexCount * stride);
+        _elementBuffer->subData(indices, indexRange.offset * _indexSize, indexCount * _indexSize);
+
+        auto geometry = SPGeometry(new Geometry(shared_from_this(), vertexRange, vertexCount, indexRange, indexCount));
+        _live.push_back(geometry.get());
+        return geometry;
+    }
+
+    void GeometryPool::release(Geometry* geometry)
+    {
+        _vertexAllocator.free(geometry->_vertices);
+        _indexAllocator.free(geometry->_indices);
+        _live.erase(std::find(_live.begin(), _live.end(), geometry));
+    }
+} // namespace Hub
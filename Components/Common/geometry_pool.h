@@ -0,0 +1,98 @@
+#pragma once
+#include "utils.h"
+#include "vertex_buffer.h"
+#include "element_buffer.h"
+#include "vertex_layout.h"
+#include "offset_allocator.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Hub
+{
+    class GeometryPool;
+    using SPGeometryPool = std::shared_ptr<GeometryPool>;
+    class Geometry;
+    using SPGeometry = std::shared_ptr<Geometry>;
+
+    // A range of vertices and indices living in a GeometryPool. Indices are local to the range and are
+    // rebased with glDrawElementsBaseVertex. The range is returned to the pool when the last reference goes.
+    class Geometry
+    {
+    public:
+        ~Geometry();
+
+        uint getBaseVertex() const;
+        uint getVertexCount() const;
+        uint getFirstIndex() const;
+        uint getIndexCount() const;
+
+        const SPGeometryPool& getPool() const;
+
+        // binds the pool buffers (skipped when already bound) and draws the range
+        void draw(GLenum mode = GL_TRIANGLES) const;
+        // draws indexCount indices starting firstIndex into the range, e.g. one level of detail
+        void draw(GLenum mode, uint firstIndex, uint indexCount) const;
+
+    private:
+        friend class GeometryPool;
+        Geometry(SPGeometryPool              pool,
+                 OffsetAllocator::Allocation vertices,
+                 uint                        vertexCount,
+                 OffsetAllocator::Allocation indices,
+                 uint                        indexCount);
+
+        SPGeometryPool              _pool;
+        OffsetAllocator::Allocation _vertices;
+        OffsetAllocator::Allocation _indices;
+        uint                        _vertexCount;
+        uint                        _indexCount;
+    };
+
+    // Shared vertex and index buffers for every mesh with the same VertexLayout. Meshes are sub-allocated
+    // with an OffsetAllocator, so drawing several of them only needs the one binding.
+    // Indices are relative to their range, so a pool of meshes with at most 65536 vertices each can store them
+    // as Type::UnsignedShort and halve the index memory.
+    class GeometryPool : public std::enable_shared_from_this<GeometryPool>
+    {
+    public:
+        static SPGeometryPool create(const VertexLayout& layout,
+                                     uint                vertexCapacity,
+                                     uint                indexCapacity,
+                                     Type::type_t        indexType = Type::UnsignedInt);
+
+        // indices are relative to the first vertex of the range, nullptr on failure. Indices of the other type
+        // are converted, into 16 bit only when the range has at most 65536 vertices.
+        SPGeometry allocate(const void* vertices, uint vertexCount, const uint* indices, uint indexCount);
+        SPGeometry allocate(const void* vertices, uint vertexCount, const uint16_t* indices, uint indexCount);
+
+        // moves all live ranges to the start of new buffers, removing the holes left by freed meshes
+        void defragment();
+
+        void bind() const;
+
+        const VertexLayout& getLayout() const;
+        Type::type_t        getIndexType() const;
+        uint                getVertexCapacity() const;
+        uint                getIndexCapacity() const;
+        uint                getFreeVertices() const;
+        uint                getFreeIndices() const;
+
+    private:
+        friend class Geometry;
+        GeometryPool(const VertexLayout& layout, uint vertexCapacity, uint indexCapacity, Type::type_t indexType);
+
+        SPGeometry upload(const void* vertices, uint vertexCount, const void* indices, uint indexCount);
+        void       release(Geometry* geometry);
+
+        VertexLayout    _layout;
+        Type::type_t    _indexType;
+        uint            _indexSize;
+        OffsetAllocator _vertexAllocator;
+        OffsetAllocator _indexAllocator;
+        SPVertexBuffer  _vertexBuffer;
+        SPElementBuffer _elementBuffer;
+
+        std::vector<Geometry*> _live;
+    };
+} // namespace Hub
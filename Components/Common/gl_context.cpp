@@ -0,0 +1,40 @@
+#include "gl_context.h"
+#include "gl_extensions.h"
+#include "gl_state.h"
+#include "gl_deletion_queue.h"
+#include "gl_resources.h"
+#include "material.h"
+#include "vertex_format_cache.h"
+#include "shader.h"
+#include "shader_hot_reload.h"
+#include "shader_stage_cache.h"
+
+namespace Hub
+{
+    void GLContext::load(GLADloadproc loader)
+    {
+        GLExtensions::load(loader);
+        // the caches may still describe the previous context
+        GLState::invalidate();
+        VertexFormatCache::clear();
+        Material::invalidate();
+    }
+
+    void GLContext::endFrame()
+    {
+        GLState::newFrame();
+        Shader::newFrame();
+        GLDeletionQueue::newFrame();
+        ShaderHotReload::update();
+    }
+
+    void GLContext::release()
+    {
+        GLResources::clear();
+        VertexFormatCache::clear();
+        GLDeletionQueue::flush();
+        ShaderHotReload::clear();
+        Shader::releasePlaceholder();
+        ShaderStageCache::clear();
+    }
+} // namespace Hub
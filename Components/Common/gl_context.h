@@ -0,0 +1,18 @@
+#pragma once
+#include "utils.h"
+
+namespace Hub
+{
+    // The hooks every window class runs around the life of its context, so Window and zh::WindowSystem keep the
+    // wrapper caches and queues in step the same way:
+    //   load()      once the context is current, loads the extensions and drops state left by an earlier context
+    //   endFrame()  after each swap
+    //   release()   before the context is destroyed, it deletes the GL objects still held
+    class GLContext
+    {
+    public:
+        static void load(GLADloadproc loader);
+        static void endFrame();
+        static void release();
+    };
+} // namespace Hub
@@ -0,0 +1,139 @@
+#include "gl_deletion_queue.h"
+#include <array>
+#include <deque>
+#include <vector>
+
+namespace Hub
+{
+    namespace
+    {
+        using NameLists = std::array<std::vector<GLuint>, GLObject::ObjectTypeCount>;
+
+        struct RetiredFrame
+        {
+            GLsync    fence = nullptr;
+            NameLists names;
+        };
+
+        struct Queue
+        {
+            NameLists                current;
+            std::deque<RetiredFrame> retired;
+        };
+
+        Queue& queue()
+        {
+            static Queue s_queue;
+            return s_queue;
+        }
+
+        bool isEmpty(const NameLists& names)
+        {
+            for (const auto& list : names)
+            {
+                if (!list.empty())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void deleteNames(NameLists& names)
+        {
+            auto& buffers = names[GLObject::Buffer];
+            if (!buffers.empty())
+            {
+                glDeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+            }
+            auto& textures = names[GLObject::Texture];
+            if (!textures.empty())
+            {
+                glDeleteTextures(static_cast<GLsizei>(textures.size()), textures.data());
+            }
+            auto& frameBuffers = names[GLObject::FrameBuffer];
+            if (!frameBuffers.empty())
+            {
+                glDeleteFramebuffers(static_cast<GLsizei>(frameBuffers.size()), frameBuffers.data());
+            }
+            auto& renderBuffers = names[GLObject::RenderBuffer];
+            if (!renderBuffers.empty())
+            {
+                glDeleteRenderbuffers(static_cast<GLsizei>(renderBuffers.size()), renderBuffers.data());
+            }
+            auto& vertexArrays = names[GLObject::VertexArray];
+            if (!vertexArrays.empty())
+            {
+                glDeleteVertexArrays(static_cast<GLsizei>(vertexArrays.size()), vertexArrays.data());
+            }
+            for (auto& list : names)
+            {
+                list.clear();
+            }
+        }
+    } // namespace
+
+    void GLDeletionQueue::release(GLObject::object_t type, GLuint name)
+    {
+        if (name != 0)
+        {
+            queue().current[type].push_back(name);
+        }
+    }
+
+    void GLDeletionQueue::newFrame()
+    {
+        auto& q = queue();
+        if (!isEmpty(q.current))
+        {
+            RetiredFrame frame;
+            frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            frame.names.swap(q.current);
+            q.retired.push_back(std::move(frame));
+        }
+
+        // frames retire in order, stop at the first one the GPU has not finished
+        while (!q.retired.empty())
+        {
+            auto&  frame  = q.retired.front();
+            GLenum result = glClientWaitSync(frame.fence, 0, 0);
+            if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED)
+            {
+                break;
+            }
+            glDeleteSync(frame.fence);
+            deleteNames(frame.names);
+            q.retired.pop_front();
+        }
+    }
+
+    void GLDeletionQueue::flush()
+    {
+        auto& q = queue();
+        for (auto& frame : q.retired)
+        {
+            glDeleteSync(frame.fence);
+            deleteNames(frame.names);
+        }
+        q.retired.clear();
+        deleteNames(q.current);
+    }
+
+    uint GLDeletionQueue::getPendingCount()
+    {
+        auto& q     = queue();
+        uint  count = 0;
+        for (const auto& list : q.current)
+        {
+            count += static_cast<uint>(list.size());
+        }
+        for (const auto& frame : q.retired)
+        {
+            for (const auto& list : frame.names)
+            {
+                count += static_cast<uint>(list.size());
+            }
+        }
+        return count;
+    }
+} // namespace Hub
@@ -0,0 +1,35 @@
+#pragma once
+#include "utils.h"
+
+namespace Hub
+{
+    namespace GLObject
+    {
+        enum object_t
+        {
+            Buffer,
+            Texture,
+            FrameBuffer,
+            RenderBuffer,
+            VertexArray,
+            ObjectTypeCount,
+        };
+    }
+
+    // Wrappers hand their GL names here instead of deleting them on the spot. Names released during a frame
+    // are fenced at the end of it and deleted in one batch per type once the GPU has passed the fence, so a
+    // destructor in the middle of a frame never makes the driver wait for pending draws.
+    class GLDeletionQueue
+    {
+    public:
+        static void release(GLObject::object_t type, GLuint name);
+
+        // fences the names released this frame and deletes the ones whose fence has signaled, called per swap
+        static void newFrame();
+
+        // deletes everything right away, for shutdown while the context is still current
+        static void flush();
+
+        static uint getPendingCount();
+    };
+} // namespace Hub
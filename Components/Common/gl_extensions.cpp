@@ -0,0 +1,232 @@
+#include "gl_extensions.h"
+#include <cstring>
+#include <iostream>
+
+#ifndef GL_VERSION_4_4
+PFNGLBUFFERSTORAGEPROC hub_glBufferStorage = nullptr;
+#endif
+
+#ifndef GL_VERSION_4_3
+PFNGLBINDVERTEXBUFFERPROC    hub_glBindVertexBuffer    = nullptr;
+PFNGLVERTEXATTRIBFORMATPROC  hub_glVertexAttribFormat  = nullptr;
+PFNGLVERTEXATTRIBBINDINGPROC hub_glVertexAttribBinding = nullptr;
+#endif
+
+#ifndef GL_VERSION_4_1
+PFNGLGETPROGRAMBINARYPROC  hub_glGetProgramBinary  = nullptr;
+PFNGLPROGRAMBINARYPROC     hub_glProgramBinary     = nullptr;
+PFNGLPROGRAMPARAMETERIPROC hub_glProgramParameteri = nullptr;
+#endif
+
+#ifndef GL_VERSION_4_1
+PFNGLGENPROGRAMPIPELINESPROC       hub_glGenProgramPipelines       = nullptr;
+PFNGLDELETEPROGRAMPIPELINESPROC    hub_glDeleteProgramPipelines    = nullptr;
+PFNGLBINDPROGRAMPIPELINEPROC       hub_glBindProgramPipeline       = nullptr;
+PFNGLUSEPROGRAMSTAGESPROC          hub_glUseProgramStages          = nullptr;
+PFNGLVALIDATEPROGRAMPIPELINEPROC   hub_glValidateProgramPipeline   = nullptr;
+PFNGLGETPROGRAMPIPELINEIVPROC      hub_glGetProgramPipelineiv      = nullptr;
+PFNGLGETPROGRAMPIPELINEINFOLOGPROC hub_glGetProgramPipelineInfoLog = nullptr;
+PFNGLPROGRAMUNIFORM1IPROC          hub_glProgramUniform1i          = nullptr;
+PFNGLPROGRAMUNIFORM1FPROC          hub_glProgramUniform1f          = nullptr;
+PFNGLPROGRAMUNIFORM2FVPROC         hub_glProgramUniform2fv         = nullptr;
+PFNGLPROGRAMUNIFORM3FVPROC         hub_glProgramUniform3fv         = nullptr;
+PFNGLPROGRAMUNIFORM4FVPROC         hub_glProgramUniform4fv         = nullptr;
+PFNGLPROGRAMUNIFORMMATRIX4FVPROC   hub_glProgramUniformMatrix4fv   = nullptr;
+#endif
+
+#ifndef GL_KHR_parallel_shader_compile
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC hub_glMaxShaderCompilerThreadsKHR = nullptr;
+#endif
+
+#ifndef GL_VERSION_4_5
+PFNGLCREATEBUFFERSPROC                       hub_glCreateBuffers                       = nullptr;
+PFNGLNAMEDBUFFERSTORAGEPROC                  hub_glNamedBufferStorage                  = nullptr;
+PFNGLNAMEDBUFFERDATAPROC                     hub_glNamedBufferData                     = nullptr;
+PFNGLNAMEDBUFFERSUBDATAPROC                  hub_glNamedBufferSubData                  = nullptr;
+PFNGLGETNAMEDBUFFERSUBDATAPROC               hub_glGetNamedBufferSubData               = nullptr;
+PFNGLMAPNAMEDBUFFERRANGEPROC                 hub_glMapNamedBufferRange                 = nullptr;
+PFNGLUNMAPNAMEDBUFFERPROC                    hub_glUnmapNamedBuffer                    = nullptr;
+PFNGLFLUSHMAPPEDNAMEDBUFFERRANGEPROC         hub_glFlushMappedNamedBufferRange         = nullptr;
+PFNGLCOPYNAMEDBUFFERSUBDATAPROC              hub_glCopyNamedBufferSubData              = nullptr;
+PFNGLCREATETEXTURESPROC                      hub_glCreateTextures                      = nullptr;
+PFNGLTEXTUREPARAMETERIPROC                   hub_glTextureParameteri                   = nullptr;
+PFNGLTEXTUREPARAMETERFVPROC                  hub_glTextureParameterfv                  = nullptr;
+PFNGLGENERATETEXTUREMIPMAPPROC               hub_glGenerateTextureMipmap               = nullptr;
+PFNGLCREATEFRAMEBUFFERSPROC                  hub_glCreateFramebuffers                  = nullptr;
+PFNGLNAMEDFRAMEBUFFERTEXTUREPROC             hub_glNamedFramebufferTexture             = nullptr;
+PFNGLNAMEDFRAMEBUFFERRENDERBUFFERPROC        hub_glNamedFramebufferRenderbuffer        = nullptr;
+PFNGLNAMEDFRAMEBUFFERDRAWBUFFERPROC          hub_glNamedFramebufferDrawBuffer          = nullptr;
+PFNGLNAMEDFRAMEBUFFERREADBUFFERPROC          hub_glNamedFramebufferReadBuffer          = nullptr;
+PFNGLCHECKNAMEDFRAMEBUFFERSTATUSPROC         hub_glCheckNamedFramebufferStatus         = nullptr;
+PFNGLCREATERENDERBUFFERSPROC                 hub_glCreateRenderbuffers                 = nullptr;
+PFNGLNAMEDRENDERBUFFERSTORAGEMULTISAMPLEPROC hub_glNamedRenderbufferStorageMultisample = nullptr;
+PFNGLCREATEVERTEXARRAYSPROC                  hub_glCreateVertexArrays                  = nullptr;
+PFNGLENABLEVERTEXARRAYATTRIBPROC             hub_glEnableVertexArrayAttrib             = nullptr;
+PFNGLVERTEXARRAYELEMENTBUFFERPROC            hub_glVertexArrayElementBuffer            = nullptr;
+PFNGLVERTEXARRAYVERTEXBUFFERPROC             hub_glVertexArrayVertexBuffer             = nullptr;
+PFNGLVERTEXARRAYATTRIBFORMATPROC             hub_glVertexArrayAttribFormat             = nullptr;
+PFNGLVERTEXARRAYATTRIBBINDINGPROC            hub_glVertexArrayAttribBinding            = nullptr;
+#endif
+
+namespace Hub
+{
+    static GLExtensions s_extensions;
+
+    void GLExtensions::load(GLADloadproc loader)
+    {
+        s_extensions       = GLExtensions();
+        s_extensions.major = GLVersion.major;
+        s_extensions.minor = GLVersion.minor;
+
+#ifndef GL_VERSION_4_4
+        hub_glBufferStorage = (PFNGLBUFFERSTORAGEPROC)loader("glBufferStorage");
+#endif
+        s_extensions.bufferStorage =
+            (hasVersion(4, 4) || hasExtension("GL_ARB_buffer_storage")) && glBufferStorage != nullptr;
+
+#ifndef GL_VERSION_4_3
+        hub_glBindVertexBuffer    = (PFNGLBINDVERTEXBUFFERPROC)loader("glBindVertexBuffer");
+        hub_glVertexAttribFormat  = (PFNGLVERTEXATTRIBFORMATPROC)loader("glVertexAttribFormat");
+        hub_glVertexAttribBinding = (PFNGLVERTEXATTRIBBINDINGPROC)loader("glVertexAttribBinding");
+#endif
+        s_extensions.vertexAttribBinding = (hasVersion(4, 3) || hasExtension("GL_ARB_vertex_attrib_binding")) &&
+                                           glBindVertexBuffer != nullptr && glVertexAttribFormat != nullptr &&
+                                           glVertexAttribBinding != nullptr;
+
+#ifndef GL_VERSION_4_1
+        hub_glGetProgramBinary  = (PFNGLGETPROGRAMBINARYPROC)loader("glGetProgramBinary");
+        hub_glProgramBinary     = (PFNGLPROGRAMBINARYPROC)loader("glProgramBinary");
+        hub_glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)loader("glProgramParameteri");
+#endif
+        if ((hasVersion(4, 1) || hasExtension("GL_ARB_get_program_binary")) && glGetProgramBinary != nullptr &&
+            glProgramBinary != nullptr && glProgramParameteri != nullptr)
+        {
+            GLint formats = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+            s_extensions.programBinary = formats > 0;
+        }
+
+#ifndef GL_VERSION_4_1
+        hub_glGenProgramPipelines       = (PFNGLGENPROGRAMPIPELINESPROC)loader("glGenProgramPipelines");
+        hub_glDeleteProgramPipelines    = (PFNGLDELETEPROGRAMPIPELINESPROC)loader("glDeleteProgramPipelines");
+        hub_glBindProgramPipeline       = (PFNGLBINDPROGRAMPIPELINEPROC)loader("glBindProgramPipeline");
+        hub_glUseProgramStages          = (PFNGLUSEPROGRAMSTAGESPROC)loader("glUseProgramStages");
+        hub_glValidateProgramPipeline   = (PFNGLVALIDATEPROGRAMPIPELINEPROC)loader("glValidateProgramPipeline");
+        hub_glGetProgramPipelineiv      = (PFNGLGETPROGRAMPIPELINEIVPROC)loader("glGetProgramPipelineiv");
+        hub_glGetProgramPipelineInfoLog = (PFNGLGETPROGRAMPIPELINEINFOLOGPROC)loader("glGetProgramPipelineInfoLog");
+        hub_glProgramUniform1i          = (PFNGLPROGRAMUNIFORM1IPROC)loader("glProgramUniform1i");
+        hub_glProgramUniform1f          = (PFNGLPROGRAMUNIFORM1FPROC)loader("glProgramUniform1f");
+        hub_glProgramUniform2fv         = (PFNGLPROGRAMUNIFORM2FVPROC)loader("glProgramUniform2fv");
+        hub_glProgramUniform3fv         = (PFNGLPROGRAMUNIFORM3FVPROC)loader("glProgramUniform3fv");
+        hub_glProgramUniform4fv         = (PFNGLPROGRAMUNIFORM4FVPROC)loader("glProgramUniform4fv");
+        hub_glProgramUniformMatrix4fv   = (PFNGLPROGRAMUNIFORMMATRIX4FVPROC)loader("glProgramUniformMatrix4fv");
+#endif
+        s_extensions.separateShaderObjects =
+            (hasVersion(4, 1) || hasExtension("GL_ARB_separate_shader_objects")) && glGenProgramPipelines != nullptr &&
+            glBindProgramPipeline != nullptr && glUseProgramStages != nullptr && glProgramParameteri != nullptr &&
+            glProgramUniform1i != nullptr && glProgramUniformMatrix4fv != nullptr;
+
+#ifndef GL_KHR_parallel_shader_compile
+        if (hasExtension("GL_KHR_parallel_shader_compile"))
+        {
+            hub_glMaxShaderCompilerThreadsKHR =
+                (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)loader("glMaxShaderCompilerThreadsKHR");
+        }
+        else if (hasExtension("GL_ARB_parallel_shader_compile"))
+        {
+            hub_glMaxShaderCompilerThreadsKHR =
+                (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)loader("glMaxShaderCompilerThreadsARB");
+        }
+#endif
+        s_extensions.parallelShaderCompile = glMaxShaderCompilerThreadsKHR != nullptr;
+        if (s_extensions.parallelShaderCompile)
+        {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF); // let the driver pick the thread count
+        }
+
+#ifndef GL_VERSION_4_5
+        hub_glCreateBuffers               = (PFNGLCREATEBUFFERSPROC)loader("glCreateBuffers");
+        hub_glNamedBufferStorage          = (PFNGLNAMEDBUFFERSTORAGEPROC)loader("glNamedBufferStorage");
+        hub_glNamedBufferData             = (PFNGLNAMEDBUFFERDATAPROC)loader("glNamedBufferData");
+        hub_glNamedBufferSubData          = (PFNGLNAMEDBUFFERSUBDATAPROC)loader("glNamedBufferSubData");
+        hub_glGetNamedBufferSubData       = (PFNGLGETNAMEDBUFFERSUBDATAPROC)loader("glGetNamedBufferSubData");
+        hub_glMapNamedBufferRange         = (PFNGLMAPNAMEDBUFFERRANGEPROC)loader("glMapNamedBufferRange");
+        hub_glUnmapNamedBuffer            = (PFNGLUNMAPNAMEDBUFFERPROC)loader("glUnmapNamedBuffer");
+        hub_glFlushMappedNamedBufferRange = (PFNGLFLUSHMAPPEDNAMEDBUFFERRANGEPROC)loader("glFlushMappedNamedBufferRange");
+        hub_glCopyNamedBufferSubData      = (PFNGLCOPYNAMEDBUFFERSUBDATAPROC)loader("glCopyNamedBufferSubData");
+        hub_glCreateTextures              = (PFNGLCREATETEXTURESPROC)loader("glCreateTextures");
+        hub_glTextureParameteri           = (PFNGLTEXTUREPARAMETERIPROC)loader("glTextureParameteri");
+        hub_glTextureParameterfv          = (PFNGLTEXTUREPARAMETERFVPROC)loader("glTextureParameterfv");
+        hub_glGenerateTextureMipmap       = (PFNGLGENERATETEXTUREMIPMAPPROC)loader("glGenerateTextureMipmap");
+        hub_glCreateFramebuffers          = (PFNGLCREATEFRAMEBUFFERSPROC)loader("glCreateFramebuffers");
+        hub_glNamedFramebufferTexture     = (PFNGLNAMEDFRAMEBUFFERTEXTUREPROC)loader("glNamedFramebufferTexture");
+        hub_glNamedFramebufferRenderbuffer =
+            (PFNGLNAMEDFRAMEBUFFERRENDERBUFFERPROC)loader("glNamedFramebufferRenderbuffer");
+        hub_glNamedFramebufferDrawBuffer = (PFNGLNAMEDFRAMEBUFFERDRAWBUFFERPROC)loader("glNamedFramebufferDrawBuffer");
+        hub_glNamedFramebufferReadBuffer = (PFNGLNAMEDFRAMEBUFFERREADBUFFERPROC)loader("glNamedFramebufferReadBuffer");
+        hub_glCheckNamedFramebufferStatus =
+            (PFNGLCHECKNAMEDFRAMEBUFFERSTATUSPROC)loader("glCheckNamedFramebufferStatus");
+        hub_glCreateRenderbuffers = (PFNGLCREATERENDERBUFFERSPROC)loader("glCreateRenderbuffers");
+        hub_glNamedRenderbufferStorageMultisample =
+            (PFNGLNAMEDRENDERBUFFERSTORAGEMULTISAMPLEPROC)loader("glNamedRenderbufferStorageMultisample");
+        hub_glCreateVertexArrays       = (PFNGLCREATEVERTEXARRAYSPROC)loader("glCreateVertexArrays");
+        hub_glEnableVertexArrayAttrib  = (PFNGLENABLEVERTEXARRAYATTRIBPROC)loader("glEnableVertexArrayAttrib");
+        hub_glVertexArrayElementBuffer = (PFNGLVERTEXARRAYELEMENTBUFFERPROC)loader("glVertexArrayElementBuffer");
+        hub_glVertexArrayVertexBuffer  = (PFNGLVERTEXARRAYVERTEXBUFFERPROC)loader("glVertexArrayVertexBuffer");
+        hub_glVertexArrayAttribFormat  = (PFNGLVERTEXARRAYATTRIBFORMATPROC)loader("glVertexArrayAttribFormat");
+        hub_glVertexArrayAttribBinding = (PFNGLVERTEXARRAYATTRIBBINDINGPROC)loader("glVertexArrayAttribBinding");
+#endif
+        // every entry point the wrappers call once the flag is set, a driver may advertise the extension
+        // without exporting all of them
+        s_extensions.directStateAccess =
+            (hasVersion(4, 5) || hasExtension("GL_ARB_direct_state_access")) &&
+            glCreateBuffers != nullptr && glNamedBufferStorage != nullptr && glNamedBufferData != nullptr &&
+            glNamedBufferSubData != nullptr && glGetNamedBufferSubData != nullptr && glMapNamedBufferRange != nullptr &&
+            glUnmapNamedBuffer != nullptr && glFlushMappedNamedBufferRange != nullptr &&
+            glCopyNamedBufferSubData != nullptr && glCreateTextures != nullptr && glTextureParameteri != nullptr &&
+            glTextureParameterfv != nullptr && glGenerateTextureMipmap != nullptr && glCreateFramebuffers != nullptr &&
+            glNamedFramebufferTexture != nullptr && glNamedFramebufferRenderbuffer != nullptr &&
+            glNamedFramebufferDrawBuffer != nullptr && glNamedFramebufferReadBuffer != nullptr &&
+            glCheckNamedFramebufferStatus != nullptr && glCreateRenderbuffers != nullptr &&
+            glNamedRenderbufferStorageMultisample != nullptr && glCreateVertexArrays != nullptr &&
+            glEnableVertexArrayAttrib != nullptr && glVertexArrayElementBuffer != nullptr &&
+            glVertexArrayVertexBuffer != nullptr && glVertexArrayAttribFormat != nullptr &&
+            glVertexArrayAttribBinding != nullptr;
+    }
+
+    void GLExtensions::print()
+    {
+        std::cout << "GL " << s_extensions.major << "." << s_extensions.minor
+                  << ", buffer storage: " << s_extensions.bufferStorage
+                  << ", vertex attrib binding: " << s_extensions.vertexAttribBinding
+                  << ", direct state access: " << s_extensions.directStateAccess
+                  << ", program binary: " << s_extensions.programBinary
+                  << ", parallel shader compile: " << s_extensions.parallelShaderCompile
+                  << ", separate shader objects: " << s_extensions.separateShaderObjects << std::endl;
+    }
+
+    const GLExtensions& GLExtensions::get()
+    {
+        return s_extensions;
+    }
+
+    bool GLExtensions::hasExtension(const char* name)
+    {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            auto extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (extension && std::strcmp(extension, name) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool GLExtensions::hasVersion(int major, int minor)
+    {
+        return s_extensions.major > major || (s_extensions.major == major && s_extensions.minor >= minor);
+    }
+} // namespace Hub
@@ -0,0 +1,259 @@
+#pragma once
+#include <glad/glad.h>
+
+// The bundled glad loader only covers gl=3.3. Newer entry points are declared here in the same
+// style as glad and loaded at runtime; callers must check the matching capability flag first.
+
+// GL 4.4 / ARB_buffer_storage
+#ifndef GL_VERSION_4_4
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_CLIENT_STORAGE_BIT 0x0200
+#define GL_BUFFER_IMMUTABLE_STORAGE 0x821F
+#define GL_BUFFER_STORAGE_FLAGS 0x8220
+typedef void(APIENTRYP PFNGLBUFFERSTORAGEPROC)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+extern PFNGLBUFFERSTORAGEPROC hub_glBufferStorage;
+#define glBufferStorage hub_glBufferStorage
+#endif
+
+// GL 4.3 / ARB_vertex_attrib_binding
+#ifndef GL_VERSION_4_3
+#define GL_VERTEX_ATTRIB_BINDING 0x82D4
+#define GL_VERTEX_ATTRIB_RELATIVE_OFFSET 0x82D5
+#define GL_VERTEX_BINDING_DIVISOR 0x82D6
+#define GL_VERTEX_BINDING_OFFSET 0x82D7
+#define GL_VERTEX_BINDING_STRIDE 0x82D8
+#define GL_MAX_VERTEX_ATTRIB_RELATIVE_OFFSET 0x82D9
+#define GL_MAX_VERTEX_ATTRIB_BINDINGS 0x82DA
+typedef void(APIENTRYP PFNGLBINDVERTEXBUFFERPROC)(GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride);
+typedef void(APIENTRYP PFNGLVERTEXATTRIBFORMATPROC)(GLuint attribindex,
+                                                     GLint size,
+                                                     GLenum type,
+                                                     GLboolean normalized,
+                                                     GLuint relativeoffset);
+typedef void(APIENTRYP PFNGLVERTEXATTRIBBINDINGPROC)(GLuint attribindex, GLuint bindingindex);
+extern PFNGLBINDVERTEXBUFFERPROC    hub_glBindVertexBuffer;
+extern PFNGLVERTEXATTRIBFORMATPROC  hub_glVertexAttribFormat;
+extern PFNGLVERTEXATTRIBBINDINGPROC hub_glVertexAttribBinding;
+#define glBindVertexBuffer hub_glBindVertexBuffer
+#define glVertexAttribFormat hub_glVertexAttribFormat
+#define glVertexAttribBinding hub_glVertexAttribBinding
+#endif
+
+// GL 4.1 / ARB_get_program_binary
+#ifndef GL_VERSION_4_1
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+typedef void(APIENTRYP PFNGLGETPROGRAMBINARYPROC)(GLuint program,
+                                                   GLsizei bufSize,
+                                                   GLsizei* length,
+                                                   GLenum* binaryFormat,
+                                                   void* binary);
+typedef void(APIENTRYP PFNGLPROGRAMBINARYPROC)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void(APIENTRYP PFNGLPROGRAMPARAMETERIPROC)(GLuint program, GLenum pname, GLint value);
+extern PFNGLGETPROGRAMBINARYPROC  hub_glGetProgramBinary;
+extern PFNGLPROGRAMBINARYPROC     hub_glProgramBinary;
+extern PFNGLPROGRAMPARAMETERIPROC hub_glProgramParameteri;
+#define glGetProgramBinary hub_glGetProgramBinary
+#define glProgramBinary hub_glProgramBinary
+#define glProgramParameteri hub_glProgramParameteri
+#endif
+
+// GL 4.1 / ARB_separate_shader_objects
+#ifndef GL_VERSION_4_1
+#define GL_VERTEX_SHADER_BIT 0x00000001
+#define GL_FRAGMENT_SHADER_BIT 0x00000002
+#define GL_GEOMETRY_SHADER_BIT 0x00000004
+#define GL_ALL_SHADER_BITS 0xFFFFFFFF
+#define GL_PROGRAM_SEPARABLE 0x8258
+#define GL_ACTIVE_PROGRAM 0x8259
+#define GL_PROGRAM_PIPELINE_BINDING 0x825A
+typedef void(APIENTRYP PFNGLGENPROGRAMPIPELINESPROC)(GLsizei n, GLuint* pipelines);
+typedef void(APIENTRYP PFNGLDELETEPROGRAMPIPELINESPROC)(GLsizei n, const GLuint* pipelines);
+typedef void(APIENTRYP PFNGLBINDPROGRAMPIPELINEPROC)(GLuint pipeline);
+typedef void(APIENTRYP PFNGLUSEPROGRAMSTAGESPROC)(GLuint pipeline, GLbitfield stages, GLuint program);
+typedef void(APIENTRYP PFNGLVALIDATEPROGRAMPIPELINEPROC)(GLuint pipeline);
+typedef void(APIENTRYP PFNGLGETPROGRAMPIPELINEIVPROC)(GLuint pipeline, GLenum pname, GLint* params);
+typedef void(APIENTRYP PFNGLGETPROGRAMPIPELINEINFOLOGPROC)(GLuint pipeline,
+                                                            GLsizei bufSize,
+                                                            GLsizei* length,
+                                                            GLchar* infoLog);
+typedef void(APIENTRYP PFNGLPROGRAMUNIFORM1IPROC)(GLuint program, GLint location, GLint v0);
+typedef void(APIENTRYP PFNGLPROGRAMUNIFORM1FPROC)(GLuint program, GLint location, GLfloat v0);
+typedef void(APIENTRYP PFNGLPROGRAMUNIFORM2FVPROC)(GLuint program, GLint location, GLsizei count, const GLfloat* value);
+typedef void(APIENTRYP PFNGLPROGRAMUNIFORM3FVPROC)(GLuint program, GLint location, GLsizei count, const GLfloat* value);
+typedef void(APIENTRYP PFNGLPROGRAMUNIFORM4FVPROC)(GLuint program, GLint location, GLsizei count, const GLfloat* value);
+typedef void(APIENTRYP PFNGLPROGRAMUNIFORMMATRIX4FVPROC)(GLuint program,
+                                                          GLint location,
+                                                          GLsizei count,
+                                                          GLboolean transpose,
+                                                          const GLfloat* value);
+extern PFNGLGENPROGRAMPIPELINESPROC       hub_glGenProgramPipelines;
+extern PFNGLDELETEPROGRAMPIPELINESPROC    hub_glDeleteProgramPipelines;
+extern PFNGLBINDPROGRAMPIPELINEPROC       hub_glBindProgramPipeline;
+extern PFNGLUSEPROGRAMSTAGESPROC          hub_glUseProgramStages;
+extern PFNGLVALIDATEPROGRAMPIPELINEPROC   hub_glValidateProgramPipeline;
+extern PFNGLGETPROGRAMPIPELINEIVPROC      hub_glGetProgramPipelineiv;
+extern PFNGLGETPROGRAMPIPELINEINFOLOGPROC hub_glGetProgramPipelineInfoLog;
+extern PFNGLPROGRAMUNIFORM1IPROC          hub_glProgramUniform1i;
+extern PFNGLPROGRAMUNIFORM1FPROC          hub_glProgramUniform1f;
+extern PFNGLPROGRAMUNIFORM2FVPROC         hub_glProgramUniform2fv;
+extern PFNGLPROGRAMUNIFORM3FVPROC         hub_glProgramUniform3fv;
+extern PFNGLPROGRAMUNIFORM4FVPROC         hub_glProgramUniform4fv;
+extern PFNGLPROGRAMUNIFORMMATRIX4FVPROC   hub_glProgramUniformMatrix4fv;
+#define glGenProgramPipelines hub_glGenProgramPipelines
+#define glDeleteProgramPipelines hub_glDeleteProgramPipelines
+#define glBindProgramPipeline hub_glBindProgramPipeline
+#define glUseProgramStages hub_glUseProgramStages
+#define glValidateProgramPipeline hub_glValidateProgramPipeline
+#define glGetProgramPipelineiv hub_glGetProgramPipelineiv
+#define glGetProgramPipelineInfoLog hub_glGetProgramPipelineInfoLog
+#define glProgramUniform1i hub_glProgramUniform1i
+#define glProgramUniform1f hub_glProgramUniform1f
+#define glProgramUniform2fv hub_glProgramUniform2fv
+#define glProgramUniform3fv hub_glProgramUniform3fv
+#define glProgramUniform4fv hub_glProgramUniform4fv
+#define glProgramUniformMatrix4fv hub_glProgramUniformMatrix4fv
+#endif
+
+// KHR_parallel_shader_compile, ARB_parallel_shader_compile has the same enums and an ARB suffixed function
+#ifndef GL_KHR_parallel_shader_compile
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void(APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+extern PFNGLMAXSHADERCOMPILERTHREADSKHRPROC hub_glMaxShaderCompilerThreadsKHR;
+#define glMaxShaderCompilerThreadsKHR hub_glMaxShaderCompilerThreadsKHR
+#endif
+
+// GL 4.5 / ARB_direct_state_access
+#ifndef GL_VERSION_4_5
+typedef void(APIENTRYP PFNGLCREATEBUFFERSPROC)(GLsizei n, GLuint* buffers);
+typedef void(APIENTRYP PFNGLNAMEDBUFFERSTORAGEPROC)(GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags);
+typedef void(APIENTRYP PFNGLNAMEDBUFFERDATAPROC)(GLuint buffer, GLsizeiptr size, const void* data, GLenum usage);
+typedef void(APIENTRYP PFNGLNAMEDBUFFERSUBDATAPROC)(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data);
+typedef void(APIENTRYP PFNGLGETNAMEDBUFFERSUBDATAPROC)(GLuint buffer, GLintptr offset, GLsizeiptr size, void* data);
+typedef void*(APIENTRYP PFNGLMAPNAMEDBUFFERRANGEPROC)(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access);
+typedef GLboolean(APIENTRYP PFNGLUNMAPNAMEDBUFFERPROC)(GLuint buffer);
+typedef void(APIENTRYP PFNGLFLUSHMAPPEDNAMEDBUFFERRANGEPROC)(GLuint buffer, GLintptr offset, GLsizeiptr length);
+typedef void(APIENTRYP PFNGLCOPYNAMEDBUFFERSUBDATAPROC)(GLuint readBuffer,
+                                                         GLuint writeBuffer,
+                                                         GLintptr readOffset,
+                                                         GLintptr writeOffset,
+                                                         GLsizeiptr size);
+typedef void(APIENTRYP PFNGLCREATETEXTURESPROC)(GLenum target, GLsizei n, GLuint* textures);
+typedef void(APIENTRYP PFNGLTEXTUREPARAMETERIPROC)(GLuint texture, GLenum pname, GLint param);
+typedef void(APIENTRYP PFNGLTEXTUREPARAMETERFVPROC)(GLuint texture, GLenum pname, const GLfloat* param);
+typedef void(APIENTRYP PFNGLGENERATETEXTUREMIPMAPPROC)(GLuint texture);
+typedef void(APIENTRYP PFNGLCREATEFRAMEBUFFERSPROC)(GLsizei n, GLuint* framebuffers);
+typedef void(APIENTRYP PFNGLNAMEDFRAMEBUFFERTEXTUREPROC)(GLuint framebuffer, GLenum attachment, GLuint texture, GLint level);
+typedef void(APIENTRYP PFNGLNAMEDFRAMEBUFFERRENDERBUFFERPROC)(GLuint framebuffer,
+                                                               GLenum attachment,
+                                                               GLenum renderbuffertarget,
+                                                               GLuint renderbuffer);
+typedef void(APIENTRYP PFNGLNAMEDFRAMEBUFFERDRAWBUFFERPROC)(GLuint framebuffer, GLenum buf);
+typedef void(APIENTRYP PFNGLNAMEDFRAMEBUFFERREADBUFFERPROC)(GLuint framebuffer, GLenum src);
+typedef GLenum(APIENTRYP PFNGLCHECKNAMEDFRAMEBUFFERSTATUSPROC)(GLuint framebuffer, GLenum target);
+typedef void(APIENTRYP PFNGLCREATERENDERBUFFERSPROC)(GLsizei n, GLuint* renderbuffers);
+typedef void(APIENTRYP PFNGLNAMEDRENDERBUFFERSTORAGEMULTISAMPLEPROC)(GLuint renderbuffer,
+                                                                      GLsizei samples,
+                                                                      GLenum internalformat,
+                                                                      GLsizei width,
+                                                                      GLsizei height);
+typedef void(APIENTRYP PFNGLCREATEVERTEXARRAYSPROC)(GLsizei n, GLuint* arrays);
+typedef void(APIENTRYP PFNGLENABLEVERTEXARRAYATTRIBPROC)(GLuint vaobj, GLuint index);
+typedef void(APIENTRYP PFNGLVERTEXARRAYELEMENTBUFFERPROC)(GLuint vaobj, GLuint buffer);
+typedef void(APIENTRYP PFNGLVERTEXARRAYVERTEXBUFFERPROC)(GLuint vaobj,
+                                                          GLuint bindingindex,
+                                                          GLuint buffer,
+                                                          GLintptr offset,
+                                                          GLsizei stride);
+typedef void(APIENTRYP PFNGLVERTEXARRAYATTRIBFORMATPROC)(GLuint vaobj,
+                                                          GLuint attribindex,
+                                                          GLint size,
+                                                          GLenum type,
+                                                          GLboolean normalized,
+                                                          GLuint relativeoffset);
+typedef void(APIENTRYP PFNGLVERTEXARRAYATTRIBBINDINGPROC)(GLuint vaobj, GLuint attribindex, GLuint bindingindex);
+extern PFNGLCREATEBUFFERSPROC                       hub_glCreateBuffers;
+extern PFNGLNAMEDBUFFERSTORAGEPROC                  hub_glNamedBufferStorage;
+extern PFNGLNAMEDBUFFERDATAPROC                     hub_glNamedBufferData;
+extern PFNGLNAMEDBUFFERSUBDATAPROC                  hub_glNamedBufferSubData;
+extern PFNGLGETNAMEDBUFFERSUBDATAPROC               hub_glGetNamedBufferSubData;
+extern PFNGLMAPNAMEDBUFFERRANGEPROC                 hub_glMapNamedBufferRange;
+extern PFNGLUNMAPNAMEDBUFFERPROC                    hub_glUnmapNamedBuffer;
+extern PFNGLFLUSHMAPPEDNAMEDBUFFERRANGEPROC         hub_glFlushMappedNamedBufferRange;
+extern PFNGLCOPYNAMEDBUFFERSUBDATAPROC              hub_glCopyNamedBufferSubData;
+extern PFNGLCREATETEXTURESPROC                      hub_glCreateTextures;
+extern PFNGLTEXTUREPARAMETERIPROC                   hub_glTextureParameteri;
+extern PFNGLTEXTUREPARAMETERFVPROC                  hub_glTextureParameterfv;
+extern PFNGLGENERATETEXTUREMIPMAPPROC               hub_glGenerateTextureMipmap;
+extern PFNGLCREATEFRAMEBUFFERSPROC                  hub_glCreateFramebuffers;
+extern PFNGLNAMEDFRAMEBUFFERTEXTUREPROC             hub_glNamedFramebufferTexture;
+extern PFNGLNAMEDFRAMEBUFFERRENDERBUFFERPROC        hub_glNamedFramebufferRenderbuffer;
+extern PFNGLNAMEDFRAMEBUFFERDRAWBUFFERPROC          hub_glNamedFramebufferDrawBuffer;
+extern PFNGLNAMEDFRAMEBUFFERREADBUFFERPROC          hub_glNamedFramebufferReadBuffer;
+extern PFNGLCHECKNAMEDFRAMEBUFFERSTATUSPROC         hub_glCheckNamedFramebufferStatus;
+extern PFNGLCREATERENDERBUFFERSPROC                 hub_glCreateRenderbuffers;
+extern PFNGLNAMEDRENDERBUFFERSTORAGEMULTISAMPLEPROC hub_glNamedRenderbufferStorageMultisample;
+extern PFNGLCREATEVERTEXARRAYSPROC                  hub_glCreateVertexArrays;
+extern PFNGLENABLEVERTEXARRAYATTRIBPROC             hub_glEnableVertexArrayAttrib;
+extern PFNGLVERTEXARRAYELEMENTBUFFERPROC            hub_glVertexArrayElementBuffer;
+extern PFNGLVERTEXARRAYVERTEXBUFFERPROC             hub_glVertexArrayVertexBuffer;
+extern PFNGLVERTEXARRAYATTRIBFORMATPROC             hub_glVertexArrayAttribFormat;
+extern PFNGLVERTEXARRAYATTRIBBINDINGPROC            hub_glVertexArrayAttribBinding;
+#define glCreateBuffers hub_glCreateBuffers
+#define glNamedBufferStorage hub_glNamedBufferStorage
+#define glNamedBufferData hub_glNamedBufferData
+#define glNamedBufferSubData hub_glNamedBufferSubData
+#define glGetNamedBufferSubData hub_glGetNamedBufferSubData
+#define glMapNamedBufferRange hub_glMapNamedBufferRange
+#define glUnmapNamedBuffer hub_glUnmapNamedBuffer
+#define glFlushMappedNamedBufferRange hub_glFlushMappedNamedBufferRange
+#define glCopyNamedBufferSubData hub_glCopyNamedBufferSubData
+#define glCreateTextures hub_glCreateTextures
+#define glTextureParameteri hub_glTextureParameteri
+#define glTextureParameterfv hub_glTextureParameterfv
+#define glGenerateTextureMipmap hub_glGenerateTextureMipmap
+#define glCreateFramebuffers hub_glCreateFramebuffers
+#define glNamedFramebufferTexture hub_glNamedFramebufferTexture
+#define glNamedFramebufferRenderbuffer hub_glNamedFramebufferRenderbuffer
+#define glNamedFramebufferDrawBuffer hub_glNamedFramebufferDrawBuffer
+#define glNamedFramebufferReadBuffer hub_glNamedFramebufferReadBuffer
+#define glCheckNamedFramebufferStatus hub_glCheckNamedFramebufferStatus
+#define glCreateRenderbuffers hub_glCreateRenderbuffers
+#define glNamedRenderbufferStorageMultisample hub_glNamedRenderbufferStorageMultisample
+#define glCreateVertexArrays hub_glCreateVertexArrays
+#define glEnableVertexArrayAttrib hub_glEnableVertexArrayAttrib
+#define glVertexArrayElementBuffer hub_glVertexArrayElementBuffer
+#define glVertexArrayVertexBuffer hub_glVertexArrayVertexBuffer
+#define glVertexArrayAttribFormat hub_glVertexArrayAttribFormat
+#define glVertexArrayAttribBinding hub_glVertexArrayAttribBinding
+#endif
+
+namespace Hub
+{
+    struct GLExtensions
+    {
+        int major = 0;
+        int minor = 0;
+
+        bool bufferStorage         = false;
+        bool vertexAttribBinding   = false;
+        bool directStateAccess     = false;
+        bool programBinary         = false; // at least one binary format is supported
+        bool parallelShaderCompile = false; // GL_COMPLETION_STATUS_KHR can be polled without blocking
+        bool separateShaderObjects = false; // program pipelines built from separable single stage programs
+
+        // must be called once the context is current and glad has been loaded
+        static void                load(GLADloadproc loader);
+        static const GLExtensions& get();
+        // one line with the version and capability flags, for diagnosing a driver
+        static void                print();
+
+        static bool hasExtension(const char* name);
+        static bool hasVersion(int major, int minor);
+    };
+} // namespace Hub
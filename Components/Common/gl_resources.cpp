@@ -0,0 +1,72 @@
+#include "gl_resources.h"
+
+namespace Hub
+{
+    namespace
+    {
+        struct Pools
+        {
+            HandlePool<VertexBuffer>  vertexBuffers;
+            HandlePool<ElementBuffer> elementBuffers;
+            HandlePool<UniformBuffer> uniformBuffers;
+            HandlePool<Texture>       textures;
+            HandlePool<FrameBuffer>   frameBuffers;
+            HandlePool<RenderBuffer>  renderBuffers;
+            HandlePool<VertexArray>   vertexArrays;
+        };
+
+        Pools& pools()
+        {
+            static Pools s_pools;
+            return s_pools;
+        }
+    } // namespace
+
+    HandlePool<VertexBuffer>& GLResources::vertexBuffers()
+    {
+        return pools().vertexBuffers;
+    }
+
+    HandlePool<ElementBuffer>& GLResources::elementBuffers()
+    {
+        return pools().elementBuffers;
+    }
+
+    HandlePool<UniformBuffer>& GLResources::uniformBuffers()
+    {
+        return pools().uniformBuffers;
+    }
+
+    HandlePool<Texture>& GLResources::textures()
+    {
+        return pools().textures;
+    }
+
+    HandlePool<FrameBuffer>& GLResources::frameBuffers()
+    {
+        return pools().frameBuffers;
+    }
+
+    HandlePool<RenderBuffer>& GLResources::renderBuffers()
+    {
+        return pools().renderBuffers;
+    }
+
+    HandlePool<VertexArray>& GLResources::vertexArrays()
+    {
+        return pools().vertexArrays;
+    }
+
+    void GLResources::clear()
+    {
+        // vertex arrays first, they reference the buffers
+        auto& p = pools();
+        p.vertexArrays.clear();
+        p.frameBuffers.clear();
+        p.renderBuffers.clear();
+        p.textures.clear();
+        p.uniformBuffers.clear();
+        p.elementBuffers.clear();
+        p.vertexBuffers.clear();
+    }
+} // namespace Hub
@@ -0,0 +1,40 @@
+#pragma once
+#include "handle_pool.h"
+#include "vertex_buffer.h"
+#include "element_buffer.h"
+#include "uniform_buffer.h"
+#include "texture.h"
+#include "frame_buffer.h"
+#include "render_buffer.h"
+#include "vertex_array.h"
+
+namespace Hub
+{
+    using VertexBufferHandle  = Handle<VertexBuffer>;
+    using ElementBufferHandle = Handle<ElementBuffer>;
+    using UniformBufferHandle = Handle<UniformBuffer>;
+    using TextureHandle       = Handle<Texture>;
+    using FrameBufferHandle   = Handle<FrameBuffer>;
+    using RenderBufferHandle  = Handle<RenderBuffer>;
+    using VertexArrayHandle   = Handle<VertexArray>;
+
+    // Handle based alternative to the SPxxx factories for objects created in bulk. RenderTargetPool keeps its
+    // FBOs and attachments here, direct use looks like
+    //   auto vbo = GLResources::vertexBuffers().create(data, length, BufferUsage::StaticDraw);
+    //   GLResources::vertexBuffers().get(vbo)->subData(...);
+    // Destroying a pooled object goes through GLDeletionQueue like every other wrapper.
+    class GLResources
+    {
+    public:
+        static HandlePool<VertexBuffer>&  vertexBuffers();
+        static HandlePool<ElementBuffer>& elementBuffers();
+        static HandlePool<UniformBuffer>& uniformBuffers();
+        static HandlePool<Texture>&       textures();
+        static HandlePool<FrameBuffer>&   frameBuffers();
+        static HandlePool<RenderBuffer>&  renderBuffers();
+        static HandlePool<VertexArray>&   vertexArrays();
+
+        // destroys every pooled object, must run while the context is still current
+        static void clear();
+    };
+} // namespace Hub
@@ -0,0 +1,367 @@
+#include "gl_state.h"
+#include "gl_extensions.h"
+#include <array>
+
+namespace Hub
+{
+    namespace
+    {
+        const GLuint Unknown = 0xFFFFFFFF;
+
+        enum BufferSlot
+        {
+            ArraySlot,
+            ElementArraySlot,
+            UniformSlot,
+            CopyReadSlot,
+            CopyWriteSlot,
+            PixelPackSlot,
+            PixelUnpackSlot,
+            TransformFeedbackSlot,
+            BufferSlotCount,
+        };
+
+        enum TextureSlot
+        {
+            Texture2DSlot,
+            TextureCubeMapSlot,
+            Texture2DMultisampleSlot,
+            Texture2DArraySlot,
+            Texture3DSlot,
+            TextureSlotCount,
+        };
+
+        const int MaxTextureUnits   = 32;
+        const int MaxIndexedBuffers = 16;
+
+        struct IndexedBinding
+        {
+            GLuint     buffer = Unknown;
+            GLintptr   offset = 0;
+            GLsizeiptr size   = 0;
+        };
+
+        struct State
+        {
+            std::array<GLuint, BufferSlotCount>                                        buffers;
+            std::array<std::array<GLuint, TextureSlotCount>, MaxTextureUnits>          textures;
+            std::array<std::array<IndexedBinding, MaxIndexedBuffers>, BufferSlotCount> indexed;
+
+            GLuint vao        = Unknown;
+            GLuint program    = Unknown;
+            GLuint pipeline   = Unknown;
+            GLenum activeUnit = Unknown;
+
+            uint textureVersion = 0; // bumped whenever a texture binding changes or becomes unknown
+
+            GLState::Stats current;
+            GLState::Stats lastFrame;
+
+            State()
+            {
+                reset();
+            }
+
+            void reset()
+            {
+                buffers.fill(Unknown);
+                for (auto& unit : textures)
+                {
+                    unit.fill(Unknown);
+                }
+                for (auto& points : indexed)
+                {
+                    points.fill(IndexedBinding());
+                }
+                vao        = Unknown;
+                program    = Unknown;
+                pipeline   = Unknown;
+                activeUnit = Unknown;
+                ++textureVersion;
+            }
+        };
+
+        State& state()
+        {
+            static State s_state;
+            return s_state;
+        }
+
+        int bufferSlot(GLenum target)
+        {
+            switch (target)
+            {
+                case GL_ARRAY_BUFFER:
+                    return ArraySlot;
+                case GL_ELEMENT_ARRAY_BUFFER:
+                    return ElementArraySlot;
+                case GL_UNIFORM_BUFFER:
+                    return UniformSlot;
+                case GL_COPY_READ_BUFFER:
+                    return CopyReadSlot;
+                case GL_COPY_WRITE_BUFFER:
+                    return CopyWriteSlot;
+                case GL_PIXEL_PACK_BUFFER:
+                    return PixelPackSlot;
+                case GL_PIXEL_UNPACK_BUFFER:
+                    return PixelUnpackSlot;
+                case GL_TRANSFORM_FEEDBACK_BUFFER:
+                    return TransformFeedbackSlot;
+            }
+            return -1;
+        }
+
+        int textureSlot(GLenum target)
+        {
+            switch (target)
+            {
+                case GL_TEXTURE_2D:
+                    return Texture2DSlot;
+                case GL_TEXTURE_CUBE_MAP:
+                    return TextureCubeMapSlot;
+                case GL_TEXTURE_2D_MULTISAMPLE:
+                    return Texture2DMultisampleSlot;
+                case GL_TEXTURE_2D_ARRAY:
+                    return Texture2DArraySlot;
+                case GL_TEXTURE_3D:
+                    return Texture3DSlot;
+            }
+            return -1;
+        }
+
+        // returns true when the call has to be issued
+        bool update(GLuint& cached, GLuint value)
+        {
+            auto& stats = state().current;
+            if (cached == value)
+            {
+                ++stats.skipped;
+                return false;
+            }
+            cached = value;
+            ++stats.issued;
+            return true;
+        }
+
+        void issueUntracked()
+        {
+            ++state().current.issued;
+        }
+    } // namespace
+
+    void GLState::bindBuffer(GLenum target, GLuint buffer)
+    {
+        int slot = bufferSlot(target);
+        if (slot < 0)
+        {
+            issueUntracked();
+            glBindBuffer(target, buffer);
+            return;
+        }
+        if (update(state().buffers[slot], buffer))
+        {
+            glBindBuffer(target, buffer);
+        }
+    }
+
+    void GLState::bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+    {
+        int slot = bufferSlot(target);
+        if (slot < 0 || index >= MaxIndexedBuffers)
+        {
+            issueUntracked();
+            glBindBufferBase(target, index, buffer);
+            return;
+        }
+        // the whole buffer is bound, size 0 marks the binding as a base binding
+        auto& binding = state().indexed[slot][index];
+        if (binding.buffer == buffer && binding.offset == 0 && binding.size == 0)
+        {
+            ++state().current.skipped;
+            return;
+        }
+        binding               = {buffer, 0, 0};
+        state().buffers[slot] = buffer; // indexed binds also replace the generic binding
+        ++state().current.issued;
+        glBindBufferBase(target, index, buffer);
+    }
+
+    void GLState::bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+    {
+        int slot = bufferSlot(target);
+        if (slot < 0 || index >= MaxIndexedBuffers)
+        {
+            issueUntracked();
+            glBindBufferRange(target, index, buffer, offset, size);
+            return;
+        }
+        auto& binding = state().indexed[slot][index];
+        if (binding.buffer == buffer && binding.offset == offset && binding.size == size)
+        {
+            ++state().current.skipped;
+            return;
+        }
+        binding               = {buffer, offset, size};
+        state().buffers[slot] = buffer;
+        ++state().current.issued;
+        glBindBufferRange(target, index, buffer, offset, size);
+    }
+
+    void GLState::bindVertexArray(GLuint vao)
+    {
+        if (update(state().vao, vao))
+        {
+            glBindVertexArray(vao);
+            // the element array binding is part of the vertex array object
+            state().buffers[ElementArraySlot] = Unknown;
+        }
+    }
+
+    void GLState::useProgram(GLuint program)
+    {
+        if (update(state().program, program))
+        {
+            glUseProgram(program);
+        }
+    }
+
+    bool GLState::isProgramInUse(GLuint program)
+    {
+        return state().program == program;
+    }
+
+    void GLState::bindProgramPipeline(GLuint pipeline)
+    {
+        if (update(state().pipeline, pipeline))
+        {
+            glBindProgramPipeline(pipeline);
+        }
+    }
+
+    void GLState::activeTexture(GLenum unit)
+    {
+        if (update(state().activeUnit, unit))
+        {
+            glActiveTexture(unit);
+        }
+    }
+
+    void GLState::bindTexture(GLenum target, GLuint texture)
+    {
+        auto& s    = state();
+        int   slot = textureSlot(target);
+        int   unit = s.activeUnit == Unknown ? -1 : static_cast<int>(s.activeUnit - GL_TEXTURE0);
+        if (slot < 0 || unit < 0 || unit >= MaxTextureUnits)
+        {
+            issueUntracked();
+            glBindTexture(target, texture);
+            ++s.textureVersion;
+            return;
+        }
+        if (update(s.textures[unit][slot], texture))
+        {
+            glBindTexture(target, texture);
+            ++s.textureVersion;
+        }
+    }
+
+    void GLState::bindTextureUnit(uint unit, GLenum target, GLuint texture)
+    {
+        int slot = textureSlot(target);
+        if (slot >= 0 && unit < MaxTextureUnits && state().textures[unit][slot] == texture)
+        {
+            ++state().current.skipped;
+            return;
+        }
+        activeTexture(GL_TEXTURE0 + unit);
+        bindTexture(target, texture);
+    }
+
+    void GLState::onDeleteBuffer(GLuint buffer)
+    {
+        auto& s = state();
+        for (int slot = 0; slot < BufferSlotCount; ++slot)
+        {
+            if (s.buffers[slot] == buffer)
+            {
+                s.buffers[slot] = Unknown;
+            }
+            for (auto& binding : s.indexed[slot])
+            {
+                if (binding.buffer == buffer)
+                {
+                    binding = IndexedBinding();
+                }
+            }
+        }
+    }
+
+    void GLState::onDeleteVertexArray(GLuint vao)
+    {
+        if (state().vao == vao)
+        {
+            state().vao                       = Unknown;
+            state().buffers[ElementArraySlot] = Unknown;
+        }
+    }
+
+    void GLState::onDeleteTexture(GLuint texture)
+    {
+        for (auto& unit : state().textures)
+        {
+            for (auto& bound : unit)
+            {
+                if (bound == texture)
+                {
+                    bound = Unknown;
+                    ++state().textureVersion;
+                }
+            }
+        }
+    }
+
+    void GLState::onDeleteProgram(GLuint program)
+    {
+        // a deleted program stays in use until another one is installed, only forget it
+        if (state().program == program)
+        {
+            state().program = Unknown;
+        }
+    }
+
+    void GLState::onDeleteProgramPipeline(GLuint pipeline)
+    {
+        // unlike a program, a deleted pipeline that is bound reverts the binding to 0
+        if (state().pipeline == pipeline)
+        {
+            state().pipeline = 0;
+        }
+    }
+
+    void GLState::invalidate()
+    {
+        state().reset();
+    }
+
+    uint GLState::getTextureVersion()
+    {
+        return state().textureVersion;
+    }
+
+    void GLState::newFrame()
+    {
+        auto& s     = state();
+        s.lastFrame = s.current;
+        s.current   = Stats();
+    }
+
+    const GLState::Stats& GLState::getFrameStats()
+    {
+        return state().lastFrame;
+    }
+
+    const GLState::Stats& GLState::getCurrentStats()
+    {
+        return state().current;
+    }
+} // namespace Hub
@@ -0,0 +1,50 @@
+#pragma once
+#include "utils.h"
+
+namespace Hub
+{
+    // Context-level cache of the GL binding state. Binds that would not change anything are skipped.
+    // The cache only knows about binds made through it: code that calls glBind* directly must call
+    // invalidate() afterwards.
+    class GLState
+    {
+    public:
+        struct Stats
+        {
+            uint issued  = 0;
+            uint skipped = 0;
+        };
+
+        static void bindBuffer(GLenum target, GLuint buffer);
+        static void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+        static void bindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+        static void bindVertexArray(GLuint vao);
+        static void useProgram(GLuint program);
+        // a pipeline only takes effect while no program is in use
+        static void bindProgramPipeline(GLuint pipeline);
+        // false as well when the program in use is unknown, e.g. after invalidate()
+        static bool isProgramInUse(GLuint program);
+        static void activeTexture(GLenum unit);
+        static void bindTexture(GLenum target, GLuint texture);
+        static void bindTextureUnit(uint unit, GLenum target, GLuint texture);
+
+        // released objects are deleted later by GLDeletionQueue and stay bound until then, so their
+        // bindings become unknown rather than 0
+        static void onDeleteBuffer(GLuint buffer);
+        static void onDeleteVertexArray(GLuint vao);
+        static void onDeleteTexture(GLuint texture);
+        static void onDeleteProgram(GLuint program);
+        static void onDeleteProgramPipeline(GLuint pipeline);
+
+        static void invalidate();
+
+        // changes whenever a texture binding changes or becomes unknown, equal versions mean every texture
+        // bound through the cache is still in place
+        static uint getTextureVersion();
+
+        // closes the per-frame counters, called once per swap
+        static void         newFrame();
+        static const Stats& getFrameStats();
+        static const Stats& getCurrentStats();
+    };
+} // namespace Hub
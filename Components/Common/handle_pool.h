@@ -0,0 +1,169 @@
+#pragma once
+#include "utils.h"
+#include <array>
+#include <cassert>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Hub
+{
+    // Generational index into a HandlePool. A slot bumps its generation when the object in it is destroyed,
+    // so an old handle to a reused slot is detected instead of silently reaching the new object.
+    template <typename T>
+    struct Handle
+    {
+        uint index      = 0;
+        uint generation = 0; // 0 is never a live generation, a default handle is null
+
+        bool isNull() const
+        {
+            return generation == 0;
+        }
+
+        bool operator==(const Handle& other) const = default;
+    };
+
+    // Stores objects in place in fixed size chunks, so records stay packed and never move.
+    // get() is unchecked in release builds and asserts on stale handles in debug builds.
+    template <typename T>
+    class HandlePool
+    {
+    public:
+        HandlePool()                             = default;
+        HandlePool(const HandlePool&)            = delete;
+        HandlePool& operator=(const HandlePool&) = delete;
+
+        ~HandlePool()
+        {
+            clear();
+        }
+
+        template <typename... Args>
+        Handle<T> create(Args&&... args)
+        {
+            uint index;
+            if (!_freeSlots.empty())
+            {
+                index = _freeSlots.back();
+                _freeSlots.pop_back();
+            }
+            else
+            {
+                index = _slotCount++;
+                if (index / ChunkSize >= _chunks.size())
+                {
+                    _chunks.push_back(std::make_unique<Chunk>());
+                }
+            }
+            Slot& slot = slotAt(index);
+            new (slot.storage) T(std::forward<Args>(args)...);
+            slot.alive = true;
+            ++_liveCount;
+            return {index, slot.generation};
+        }
+
+        void destroy(Handle<T> handle)
+        {
+            if (!isValid(handle))
+            {
+                assert(handle.isNull() && "HandlePool: destroying a stale handle");
+                return;
+            }
+            Slot& slot = slotAt(handle.index);
+            object(slot)->~T();
+            slot.alive = false;
+            if (++slot.generation == 0)
+            {
+                slot.generation = 1;
+            }
+            _freeSlots.push_back(handle.index);
+            --_liveCount;
+        }
+
+        bool isValid(Handle<T> handle) const
+        {
+            if (handle.isNull() || handle.index >= _slotCount)
+            {
+                return false;
+            }
+            const Slot& slot = slotAt(handle.index);
+            return slot.alive && slot.generation == handle.generation;
+        }
+
+        T* get(Handle<T> handle)
+        {
+            assert(isValid(handle) && "HandlePool: stale or null handle");
+            return object(slotAt(handle.index));
+        }
+
+        const T* get(Handle<T> handle) const
+        {
+            assert(isValid(handle) && "HandlePool: stale or null handle");
+            return object(const_cast<Slot&>(slotAt(handle.index)));
+        }
+
+        uint size() const
+        {
+            return _liveCount;
+        }
+
+        template <typename Func>
+        void forEach(Func func)
+        {
+            for (uint index = 0; index < _slotCount; ++index)
+            {
+                Slot& slot = slotAt(index);
+                if (slot.alive)
+                {
+                    func(Handle<T>{index, slot.generation}, *object(slot));
+                }
+            }
+        }
+
+        void clear()
+        {
+            for (uint index = 0; index < _slotCount; ++index)
+            {
+                Slot& slot = slotAt(index);
+                if (slot.alive)
+                {
+                    destroy({index, slot.generation});
+                }
+            }
+        }
+
+    private:
+        static constexpr uint ChunkSize = 64;
+
+        struct Slot
+        {
+            alignas(T) unsigned char storage[sizeof(T)];
+            uint generation = 1;
+            bool alive      = false;
+        };
+
+        using Chunk = std::array<Slot, ChunkSize>;
+
+        Slot& slotAt(uint index)
+        {
+            return (*_chunks[index / ChunkSize])[index % ChunkSize];
+        }
+
+        const Slot& slotAt(uint index) const
+        {
+            return (*_chunks[index / ChunkSize])[index % ChunkSize];
+        }
+
+        static T* object(Slot& slot)
+        {
+            return std::launder(reinterpret_cast<T*>(slot.storage));
+        }
+
+        std::vector<std::unique_ptr<Chunk>> _chunks;
+        std::vector<uint>                   _freeSlots;
+        uint                                _slotCount = 0;
+        uint                                _liveCount = 0;
+    };
+} // namespace Hub
@@ -0,0 +1,102 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Hub
+{
+    SPMappedFile MappedFile::open(const std::string& path)
+    {
+        SPMappedFile file(new MappedFile());
+#ifdef _WIN32
+        file->_file = CreateFileA(path.c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                                  nullptr);
+        if (file->_file == INVALID_HANDLE_VALUE)
+        {
+            file->_file = nullptr;
+            return nullptr;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file->_file, &size) || size.QuadPart == 0)
+        {
+            return nullptr;
+        }
+        file->_mapping = CreateFileMappingA(file->_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (file->_mapping == nullptr)
+        {
+            return nullptr;
+        }
+        file->_data = static_cast<const unsigned char*>(MapViewOfFile(file->_mapping, FILE_MAP_READ, 0, 0, 0));
+        file->_size = static_cast<size_t>(size.QuadPart);
+#else
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+        {
+            return nullptr;
+        }
+        struct stat info;
+        if (fstat(descriptor, &info) != 0 || info.st_size == 0)
+        {
+            close(descriptor);
+            return nullptr;
+        }
+        // the mapping keeps the file referenced, the descriptor is not needed past mmap
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+        close(descriptor);
+        if (data == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        file->_data = static_cast<const unsigned char*>(data);
+        file->_size = static_cast<size_t>(info.st_size);
+#endif
+        return file->_data != nullptr ? file : nullptr;
+    }
+
+    MappedFile::~MappedFile()
+    {
+#ifdef _WIN32
+        if (_data != nullptr)
+        {
+            UnmapViewOfFile(_data);
+        }
+        if (_mapping != nullptr)
+        {
+            CloseHandle(_mapping);
+        }
+        if (_file != nullptr)
+        {
+            CloseHandle(_file);
+        }
+#else
+        if (_data != nullptr)
+        {
+            munmap(const_cast<unsigned char*>(_data), _size);
+        }
+#endif
+    }
+
+    const unsigned char* MappedFile::getData() const
+    {
+        return _data;
+    }
+
+    size_t MappedFile::getSize() const
+    {
+        return _size;
+    }
+} // namespace Hub
@@ -0,0 +1,45 @@
+#pragma once
+#include "utils.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace Hub
+{
+    class MappedFile;
+    using SPMappedFile = std::shared_ptr<MappedFile>;
+
+    // Read only view of a whole file mapped into memory. Pages are loaded by the OS on first touch, so data
+    // can be handed to GL straight from the mapping without reading it into a buffer first.
+    class MappedFile
+    {
+    public:
+        // nullptr when the file is missing, empty or cannot be mapped
+        static SPMappedFile open(const std::string& path);
+        ~MappedFile();
+
+        const unsigned char* getData() const;
+        size_t               getSize() const;
+
+        // pointer to a T at offset, nullptr when count Ts would run past the end of the file
+        template <typename T>
+        const T* at(size_t offset, size_t count = 1) const
+        {
+            if (offset > _size || count > (_size - offset) / sizeof(T))
+            {
+                return nullptr;
+            }
+            return reinterpret_cast<const T*>(_data + offset);
+        }
+
+    private:
+        MappedFile() = default;
+
+        const unsigned char* _data = nullptr;
+        size_t               _size = 0;
+#ifdef _WIN32
+        void* _file    = nullptr;
+        void* _mapping = nullptr;
+#endif
+    };
+} // namespace Hub
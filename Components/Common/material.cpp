@@ -0,0 +1,136 @@
+#include "material.h"
+#include "gl_state.h"
+
+namespace Hub
+{
+    namespace
+    {
+        // the material bound last and the GLState texture version right after, a version of 0 is never current
+        struct Bound
+        {
+            uint64_t hash           = 0;
+            uint     textureVersion = 0;
+        };
+
+        Bound& bound()
+        {
+            static Bound s_bound;
+            return s_bound;
+        }
+
+        uint64_t fnv1a(uint64_t hash, const void* data, size_t size)
+        {
+            auto bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+    } // namespace
+
+    SPMaterial Material::create(const std::vector<MeshData::Texture>& textures)
+    {
+        return SPMaterial(new Material(textures));
+    }
+
+    void Material::bind(Shader& shader)
+    {
+        // sampler writes are cheap, the shader keeps a copy and drops the ones that change nothing. Until an
+        // async build is finished there are no locations to resolve. It is not finished from here: use() bound
+        // the placeholder, and the real program has to wait for the next use().
+        if (!shader.isBuilding())
+        {
+            const auto& binding = resolve(shader);
+            for (uint i = 0; i < _slots.size(); ++i)
+            {
+                shader.setInt(binding.samplers[i], i);
+            }
+        }
+
+        auto& last = bound();
+        if (last.hash == _hash && last.textureVersion == GLState::getTextureVersion())
+        {
+            return;
+        }
+        for (uint i = 0; i < _slots.size(); ++i)
+        {
+            GLState::bindTextureUnit(i, GL_TEXTURE_2D, *_slots[i].texture);
+        }
+        GLState::activeTexture(GL_TEXTURE0);
+        last.hash           = _hash;
+        last.textureVersion = GLState::getTextureVersion();
+    }
+
+    uint64_t Material::getHash() const
+    {
+        return _hash;
+    }
+
+    uint Material::getTextureCount() const
+    {
+        return static_cast<uint>(_slots.size());
+    }
+
+    void Material::invalidate()
+    {
+        bound() = Bound{};
+    }
+
+    Material::Material(const std::vector<MeshData::Texture>& textures)
+    {
+        unsigned int diffuseNr  = 1;
+        unsigned int specularNr = 1;
+        _hash                   = 14695981039346656037ull;
+        for (const auto& texture : textures)
+        {
+            std::string number;
+            if (texture.type == "texture_diffuse")
+            {
+                number = std::to_string(diffuseNr++);
+            }
+            else if (texture.type == "texture_specular")
+            {
+                number = std::to_string(specularNr++);
+            }
+            _slots.push_back({texture.ptr, texture.type + number});
+
+            GLuint id = *texture.ptr;
+            _hash     = fnv1a(_hash, &id, sizeof(id));
+            _hash     = fnv1a(_hash, _slots.back().sampler.data(), _slots.back().sampler.size());
+        }
+    }
+
+    const Material::ShaderBinding& Material::resolve(Shader& shader)
+    {
+        ShaderBinding* binding = nullptr;
+        for (auto& candidate : _bindings)
+        {
+            if (candidate.shader == &shader)
+            {
+                binding = &candidate;
+                break;
+            }
+        }
+        if (!binding)
+        {
+            _bindings.emplace_back();
+            binding         = &_bindings.back();
+            binding->shader = &shader;
+        }
+        else if (binding->generation == shader.getGeneration())
+        {
+            return *binding;
+        }
+
+        // first use, or a reloaded program with other locations
+        binding->generation = shader.getGeneration();
+        binding->samplers.clear();
+        for (const auto& slot : _slots)
+        {
+            binding->samplers.push_back(shader.getUniform(slot.sampler));
+        }
+        return *binding;
+    }
+} // namespace Hub
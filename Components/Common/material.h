@@ -0,0 +1,69 @@
+#pragma once
+#include "utils.h"
+#include "shader.h"
+#include "texture.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Hub
+{
+    namespace MeshData
+    {
+        struct Texture
+        {
+            /*unsigned int id;*/
+            SPTexture   ptr;
+            std::string type;
+            std::string path;
+        };
+    } // namespace MeshData
+
+    class Material;
+    using SPMaterial = std::shared_ptr<Material>;
+
+    // The textures of a mesh with everything a draw needs resolved up front: texture i goes to unit i and to the
+    // sampler named after its type and rank ("texture_diffuse1", "texture_specular2"...). Sampler handles are
+    // looked up once per shader and again after it is reloaded. Meshes with the same textures can share one
+    // Material, and binding it again while GLState has not seen a texture bind since skips the texture binds.
+    class Material
+    {
+    public:
+        // every texture must be loaded, the hash is taken over the texture objects
+        static SPMaterial create(const std::vector<MeshData::Texture>& textures);
+
+        // binds the textures and sets the samplers of shader, which must be in use
+        void bind(Shader& shader);
+
+        // equal for materials binding the same textures to the same samplers
+        uint64_t getHash() const;
+        uint     getTextureCount() const;
+
+        // forgets the material bound last, for a new context
+        static void invalidate();
+
+    private:
+        struct Slot
+        {
+            SPTexture   texture;
+            std::string sampler;
+        };
+
+        // sampler handles of one shader, valid until its generation changes
+        struct ShaderBinding
+        {
+            const Shader*              shader     = nullptr;
+            unsigned int               generation = 0;
+            std::vector<UniformHandle> samplers;
+        };
+
+        Material(const std::vector<MeshData::Texture>& textures);
+
+        const ShaderBinding& resolve(Shader& shader);
+
+        std::vector<Slot>          _slots;
+        std::vector<ShaderBinding> _bindings;
+        uint64_t                   _hash = 0;
+    };
+} // namespace Hub
@@ -1,57 +1,116 @@
 #include "mesh.h"
+#include "vertex_format_cache.h"
+#include <algorithm>
 
 namespace Hub
 {
     Mesh::Mesh(std::vector<MeshData::Vertex>  vertices,
                std::vector<unsigned int>      indices,
-               std::vector<MeshData::Texture> textures)
+               std::vector<MeshData::Texture> textures,
+               SPGeometryPool                 pool) :
+        vertices(std::move(vertices)), indices(std::move(indices)), textures(std::move(textures))
     {
-        this->vertices = vertices;
-        this->indices  = indices;
-        this->textures = textures;
-        setupMesh();
+        setupMesh(pool, this->vertices.data(), this->vertices.size(), this->indices.data(), this->indices.size());
     }
 
-    void Mesh::draw(Shader& shader)
+    Mesh::Mesh(const void*                      vertexData,
+               size_t                           vertexCount,
+               MeshData::VertexFormat::format_t vertexFormat,
+               const void*                      indexData,
+               size_t                           indexCount,
+               Type::type_t                     indexType,
+               std::vector<MeshData::Texture>   textures,
+               SPGeometryPool                   pool) :
+        textures(std::move(textures)), indexType(indexType), vertexFormat(vertexFormat)
     {
-        unsigned int diffuseNr  = 1;
-        unsigned int specularNr = 1;
-        for (unsigned int i = 0; i < textures.size(); ++i)
+        setupMesh(pool, vertexData, vertexCount, indexData, indexCount);
+    }
+
+    void Mesh::draw(Shader& shader, uint lod)
+    {
+        getMaterial()->bind(shader);
+        if (vertexFormat == MeshData::VertexFormat::Quantized)
         {
-            glActiveTexture(GL_TEXTURE0 + i);
-            std::string number;
-            std::string name = textures[i].type;
-            if (name == "texture_diffuse")
+            // unorm16 positions span the mesh bounds
+            auto& uniforms = quantizationUniforms;
+            if (uniforms.shader != &shader || uniforms.generation != shader.getGeneration())
             {
-                number = std::to_string(diffuseNr++);
+                uniforms.shader     = &shader;
+                uniforms.generation = shader.getGeneration();
+                uniforms.scale      = shader.getUniform("positionScale");
+                uniforms.offset     = shader.getUniform("positionOffset");
             }
-            else if (name == "texture_specular")
-            {
-                number = std::to_string(specularNr++);
-            }
-            shader.setInt((name + number).c_str(), i);
-            glBindTexture(GL_TEXTURE_2D, *(textures[i].ptr));
+            shader.setVec3(uniforms.scale, bounds.max - bounds.min);
+            shader.setVec3(uniforms.offset, bounds.min);
+        }
+        shader.flush();
+
+        uint firstIndex = 0;
+        uint indexCount = static_cast<uint>(elementCount);
+        if (!lods.empty())
+        {
+            const auto& level = lods[std::min<size_t>(lod, lods.size() - 1)];
+            firstIndex        = level.firstIndex;
+            indexCount        = level.indexCount;
         }
-        glActiveTexture(GL_TEXTURE0);
 
-        // draw mesh
-        glBindVertexArray(*VAO);
+        // draw mesh, meshes sharing the vertex format share the VAO
+        if (geometry)
+        {
+            geometry->draw(GL_TRIANGLES, firstIndex, indexCount);
+            glCheckError();
+            return;
+        }
+        VertexFormatCache::bind(MeshData::layoutOf(vertexFormat), *VBO, EBO.get());
         glCheckError();
-        glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES,
+                       static_cast<GLsizei>(indexCount),
+                       indexType,
+                       (GLvoid*)(size_t(firstIndex) * Type::sizeOf(indexType)));
         glCheckError();
-        glBindVertexArray(0);
     }
 
-    void Mesh::setupMesh()
+    const SPMaterial& Mesh::getMaterial()
+    {
+        if (!material)
+        {
+            material = Material::create(textures);
+        }
+        return material;
+    }
+
+    const void* Mesh::getGeometryKey() const
+    {
+        if (geometry)
+        {
+            return geometry->getPool().get();
+        }
+        return VBO.get();
+    }
+
+    void Mesh::setupMesh(const SPGeometryPool& pool,
+                         const void*           vertexData,
+                         size_t                vertexCount,
+                         const void*           indexData,
+                         size_t                indexCount)
     {
-        VAO = VertexArray::create();
-        VBO = VertexBuffer::create(&vertices[0], vertices.size() * sizeof(MeshData::Vertex), BufferUsage::StaticDraw);
-        EBO = ElementBuffer::create(&indices[0], indices.size() * sizeof(unsigned int), BufferUsage::StaticDraw);
-        VAO->bindElements(*EBO);
-        VAO->bindAttribute(0, 3, *VBO, Type::Float, sizeof(MeshData::Vertex), offsetof(MeshData::Vertex, position));
-        VAO->bindAttribute(1, 3, *VBO, Type::Float, sizeof(MeshData::Vertex), offsetof(MeshData::Vertex, normal));
-        VAO->bindAttribute(2, 2, *VBO, Type::Float, sizeof(MeshData::Vertex), offsetof(MeshData::Vertex, texCoords));
-        glBindVertexArray(0);
+        elementCount = indexCount;
+        if (pool)
+        {
+            // the pool converts to its own index type
+            auto vertices = static_cast<uint>(vertexCount);
+            auto count    = static_cast<uint>(indexCount);
+            geometry      = indexType == Type::UnsignedShort
+                                ? pool->allocate(vertexData, vertices, static_cast<const uint16_t*>(indexData), count)
+                                : pool->allocate(vertexData, vertices, static_cast<const uint*>(indexData), count);
+            if (geometry)
+            {
+                return;
+            }
+        }
+        size_t stride = MeshData::layoutOf(vertexFormat).getStride();
+        VBO           = VertexBuffer::create(vertexData, vertexCount * stride, BufferUsage::StaticDraw);
+        EBO           = ElementBuffer::create(indexData, indexCount * Type::sizeOf(indexType), BufferUsage::StaticDraw);
     }
 
 } // namespace Hub
\ No newline at end of file
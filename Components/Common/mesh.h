@@ -1,10 +1,14 @@
 #pragma once
 #include "gmath.h"
 #include "shader.h"
-#include "vertex_array.h"
+#include "vertex_layout.h"
 #include "vertex_buffer.h"
 #include "element_buffer.h"
 #include "texture.h"
+#include "material.h"
+#include "geometry_pool.h"
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -19,12 +23,120 @@ namespace Hub
             Vector2 texCoords;
         };
 
-        struct Texture
+        constexpr VertexLayout vertexLayout = VertexLayout(sizeof(Vertex))
+                                                  .add(0, 3, Type::Float, offsetof(Vertex, position))
+                                                  .add(1, 3, Type::Float, offsetof(Vertex, normal))
+                                                  .add(2, 2, Type::Float, offsetof(Vertex, texCoords));
+
+        // Compact alternatives to Vertex, picked per Model at import and packed by VertexQuantizer:
+        //   Full       Vertex, 32 bytes
+        //   Packed     float position, 10_10_10_2 normal, half float texCoords, 20 bytes
+        //   Quantized  unorm16 position relative to the mesh bounds, 16 bytes. Shaders are built with
+        //              definesFor(Quantized) and map it back with positionScale and positionOffset.
+        // The attributes keep their locations and arrive in the shader as floats, normals are not renormalized.
+        namespace VertexFormat
+        {
+            enum format_t
+            {
+                Full,
+                Packed,
+                Quantized,
+                Count,
+            };
+        } // namespace VertexFormat
+
+        struct PackedVertex
+        {
+            Vector3  position;
+            uint32_t normal;    // snorm 10_10_10_2, w unused
+            uint32_t texCoords; // two halfs
+        };
+
+        struct QuantizedVertex
+        {
+            uint16_t position[4]; // unorm16 inside the bounds, [3] is padding
+            uint32_t normal;
+            uint32_t texCoords;
+        };
+
+        constexpr VertexLayout packedVertexLayout =
+            VertexLayout(sizeof(PackedVertex))
+                .add(0, 3, Type::Float, offsetof(PackedVertex, position))
+                .add(1, 4, Type::Int2101010Rev, offsetof(PackedVertex, normal), true)
+                .add(2, 2, Type::HalfFloat, offsetof(PackedVertex, texCoords));
+
+        constexpr VertexLayout quantizedVertexLayout =
+            VertexLayout(sizeof(QuantizedVertex))
+                .add(0, 3, Type::UnsignedShort, offsetof(QuantizedVertex, position), true)
+                .add(1, 4, Type::Int2101010Rev, offsetof(QuantizedVertex, normal), true)
+                .add(2, 2, Type::HalfFloat, offsetof(QuantizedVertex, texCoords));
+
+        inline const VertexLayout& layoutOf(VertexFormat::format_t format)
+        {
+            switch (format)
+            {
+                case VertexFormat::Packed:
+                    return packedVertexLayout;
+                case VertexFormat::Quantized:
+                    return quantizedVertexLayout;
+                default:
+                    return vertexLayout;
+            }
+        }
+
+        // HUB_PACKED_VERTEX for both packed formats, HUB_QUANTIZED_POSITION for Quantized
+        inline ShaderDefines definesFor(VertexFormat::format_t format)
+        {
+            ShaderDefines defines;
+            if (format != VertexFormat::Full)
+            {
+                defines["HUB_PACKED_VERTEX"] = "1";
+            }
+            if (format == VertexFormat::Quantized)
+            {
+                defines["HUB_QUANTIZED_POSITION"] = "1";
+            }
+            return defines;
+        }
+
+        // axis aligned box around the vertex positions, empty (min > max) until a point is added
+        struct Bounds
         {
-            /*unsigned int id;*/
-            SPTexture   ptr;
-            std::string type;
-            std::string path;
+            Vector3 min = Vector3(std::numeric_limits<float>::max());
+            Vector3 max = Vector3(std::numeric_limits<float>::lowest());
+
+            void add(const Vector3& point)
+            {
+                min = glm::min(min, point);
+                max = glm::max(max, point);
+            }
+
+            void add(const Bounds& bounds)
+            {
+                min = glm::min(min, bounds.min);
+                max = glm::max(max, bounds.max);
+            }
+        };
+
+        // a level of detail, a range of the mesh's indices over its full vertex buffer. error is how far the level
+        // strays from the full mesh, in model units.
+        struct Lod
+        {
+            uint  firstIndex = 0;
+            uint  indexCount = 0;
+            float error      = 0.f;
+        };
+
+        constexpr uint MaxLods = 4;
+
+        // how Model imports a file, a cooked file made with other options is imported again
+        struct ImportOptions
+        {
+            VertexFormat::format_t vertexFormat = VertexFormat::Full;
+            uint                   lodCount     = MaxLods; // levels including the full mesh, 1 disables them
+            float                  lodError     = 0.02f;   // largest error of a level, relative to the bounds diagonal
+
+            bool operator==(const ImportOptions& other) const = default;
         };
     } // namespace MeshData
 
@@ -34,18 +146,58 @@ namespace Hub
         std::vector<MeshData::Vertex>  vertices;
         std::vector<unsigned int>      indices;
         std::vector<MeshData::Texture> textures;
+        MeshData::Bounds               bounds;
+        std::vector<MeshData::Lod>     lods; // finest first, empty when indices are a single level
+        // made from textures on first use unless set before, meshes with the same textures can share one
+        SPMaterial                     material;
 
+        // with a pool the geometry is sub-allocated from it instead of getting its own buffers
         Mesh(std::vector<MeshData::Vertex>  vertices,
              std::vector<unsigned int>      indices,
-             std::vector<MeshData::Texture> textures);
+             std::vector<MeshData::Texture> textures,
+             SPGeometryPool                 pool = nullptr);
+        // uploads straight from memory the mesh does not keep, e.g. a mapped .hubmesh. vertices and indices
+        // stay empty. vertexData holds vertexFormat vertices, indexType is Type::UnsignedInt or
+        // Type::UnsignedShort. bounds must be set before drawing a Quantized mesh.
+        Mesh(const void*                      vertexData,
+             size_t                           vertexCount,
+             MeshData::VertexFormat::format_t vertexFormat,
+             const void*                      indexData,
+             size_t                           indexCount,
+             Type::type_t                     indexType,
+             std::vector<MeshData::Texture>   textures,
+             SPGeometryPool                   pool = nullptr);
 
-        void draw(Shader& shader);
+        // lod is clamped to the levels the mesh has
+        void draw(Shader& shader, uint lod = 0);
+
+        const SPMaterial& getMaterial();
+        // the same for meshes drawn from the same vertex and index buffers, e.g. the meshes of one pool
+        const void*       getGeometryKey() const;
 
     private:
-        SPVertexArray   VAO;
         SPVertexBuffer  VBO;
         SPElementBuffer EBO;
+        SPGeometry      geometry;
+        size_t          elementCount = 0;
+        Type::type_t    indexType    = Type::UnsignedInt;
+
+        MeshData::VertexFormat::format_t vertexFormat = MeshData::VertexFormat::Full;
+
+        // positionScale and positionOffset of the shader drawn last, valid until its generation changes
+        struct QuantizationUniforms
+        {
+            const Shader* shader     = nullptr;
+            unsigned int  generation = 0;
+            UniformHandle scale;
+            UniformHandle offset;
+        };
+        QuantizationUniforms quantizationUniforms;
 
-        void setupMesh();
+        void setupMesh(const SPGeometryPool& pool,
+                       const void*           vertexData,
+                       size_t                vertexCount,
+                       const void*           indexData,
+                       size_t                indexCount);
     };
 } // namespace Hub
\ No newline at end of file
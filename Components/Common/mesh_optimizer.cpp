@@ -0,0 +1,322 @@
+#include "mesh_optimizer.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
+namespace Hub
+{
+    namespace
+    {
+        struct VertexHash
+        {
+            // FNV-1a over the bytes, Vertex is all floats without padding
+            size_t operator()(const MeshData::Vertex& vertex) const
+            {
+                const auto* bytes = reinterpret_cast<const unsigned char*>(&vertex);
+                uint64_t    value = 14695981039346656037ull;
+                for (size_t i = 0; i < sizeof(MeshData::Vertex); ++i)
+                {
+                    value ^= bytes[i];
+                    value *= 1099511628211ull;
+                }
+                return static_cast<size_t>(value);
+            }
+        };
+
+        struct VertexEqual
+        {
+            bool operator()(const MeshData::Vertex& a, const MeshData::Vertex& b) const
+            {
+                return std::memcmp(&a, &b, sizeof(MeshData::Vertex)) == 0;
+            }
+        };
+
+        // triangles using each vertex, offsets[v] to offsets[v + 1] in triangles
+        struct Adjacency
+        {
+            std::vector<uint> offsets;
+            std::vector<uint> triangles;
+
+            Adjacency(const std::vector<unsigned int>& indices, uint vertexCount) : offsets(vertexCount + 1, 0)
+            {
+                for (auto index : indices)
+                {
+                    ++offsets[index + 1];
+                }
+                std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+                triangles.resize(indices.size());
+                std::vector<uint> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < indices.size(); ++i)
+                {
+                    triangles[cursor[indices[i]]++] = static_cast<uint>(i / 3);
+                }
+            }
+        };
+    } // namespace
+
+    MeshOptimizer::Stats
+    MeshOptimizer::analyze(const std::vector<unsigned int>& indices, uint vertexCount, uint cacheSize)
+    {
+        Stats stats;
+        if (indices.empty())
+        {
+            return stats;
+        }
+
+        // FIFO, a vertex is in the cache while fewer than cacheSize misses happened since its own
+        std::vector<uint> missedAt(vertexCount, 0);
+        std::vector<bool> referenced(vertexCount, false);
+        uint              misses = 0;
+        uint              unique = 0;
+        for (auto index : indices)
+        {
+            if (missedAt[index] == 0 || misses - missedAt[index] + 1 > cacheSize)
+            {
+                missedAt[index] = ++misses;
+            }
+            if (!referenced[index])
+            {
+                referenced[index] = true;
+                ++unique;
+            }
+        }
+        stats.misses    = misses;
+        stats.triangles = static_cast<uint>(indices.size() / 3);
+        stats.vertices  = unique;
+        stats.acmr      = float(misses) / float(stats.triangles);
+        stats.atvr      = float(misses) / float(unique);
+        return stats;
+    }
+
+    uint MeshOptimizer::weld(std::vector<MeshData::Vertex>& vertices, std::vector<unsigned int>& indices)
+    {
+        std::unordered_map<MeshData::Vertex, uint, VertexHash, VertexEqual> first;
+        first.reserve(vertices.size());
+        std::vector<uint> remap(vertices.size());
+        for (uint i = 0; i < vertices.size(); ++i)
+        {
+            remap[i] = first.emplace(vertices[i], i).first->second;
+        }
+        for (auto& index : indices)
+        {
+            index = remap[index];
+        }
+        // the duplicates are now unreferenced, the fetch remap drops them
+        return static_cast<uint>(vertices.size() - first.size());
+    }
+
+    void MeshOptimizer::optimizeVertexCache(std::vector<unsigned int>& indices,
+                                            uint                       vertexCount,
+                                            std::vector<uint>*         clusters,
+                                            uint                       cacheSize)
+    {
+        uint triangleCount = static_cast<uint>(indices.size() / 3);
+        if (triangleCount == 0)
+        {
+            return;
+        }
+
+        Adjacency         adjacency(indices, vertexCount);
+        std::vector<uint> live(vertexCount);
+        for (uint v = 0; v < vertexCount; ++v)
+        {
+            live[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+        }
+        std::vector<uint>         cacheTime(vertexCount, 0);
+        std::vector<bool>         emitted(triangleCount, false);
+        std::vector<uint>         deadEnd;
+        std::vector<uint>         candidates;
+        std::vector<unsigned int> result;
+        result.reserve(indices.size());
+
+        uint time   = cacheSize + 1;
+        uint cursor = 0; // next vertex to try when the dead end stack is exhausted
+        int  fan    = 0;
+        if (clusters)
+        {
+            clusters->assign(1, 0);
+        }
+        while (fan >= 0)
+        {
+            // emit every remaining triangle around the fanning vertex
+            candidates.clear();
+            for (uint a = adjacency.offsets[fan]; a < adjacency.offsets[fan + 1]; ++a)
+            {
+                uint triangle = adjacency.triangles[a];
+                if (emitted[triangle])
+                {
+                    continue;
+                }
+                emitted[triangle] = true;
+                for (uint k = 0; k < 3; ++k)
+                {
+                    uint v = indices[triangle * 3 + k];
+                    result.push_back(v);
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    --live[v];
+                    if (time - cacheTime[v] > cacheSize)
+                    {
+                        cacheTime[v] = time++;
+                    }
+                }
+            }
+
+            // next fan: the candidate that stays longest in the cache once its remaining triangles are emitted
+            int  next     = -1;
+            uint priority = 0;
+            for (uint v : candidates)
+            {
+                if (live[v] == 0)
+                {
+                    continue;
+                }
+                uint p = 0;
+                if (time - cacheTime[v] + 2 * live[v] <= cacheSize)
+                {
+                    p = time - cacheTime[v];
+                }
+                if (next < 0 || p > priority)
+                {
+                    priority = p;
+                    next     = static_cast<int>(v);
+                }
+            }
+            if (next < 0)
+            {
+                // dead end, fall back to recently used vertices and then to the input order
+                while (!deadEnd.empty() && next < 0)
+                {
+                    uint v = deadEnd.back();
+                    deadEnd.pop_back();
+                    if (live[v] > 0)
+                    {
+                        next = static_cast<int>(v);
+                    }
+                }
+                while (cursor < vertexCount && next < 0)
+                {
+                    if (live[cursor] > 0)
+                    {
+                        next = static_cast<int>(cursor);
+                    }
+                    ++cursor;
+                }
+                if (clusters && next >= 0)
+                {
+                    clusters->push_back(static_cast<uint>(result.size() / 3));
+                }
+            }
+            fan = next;
+        }
+        indices.swap(result);
+    }
+
+    void MeshOptimizer::optimizeOverdraw(std::vector<unsigned int>&           indices,
+                                         const std::vector<MeshData::Vertex>& vertices,
+                                         const std::vector<uint>&             clusters,
+                                         float                                threshold)
+    {
+        uint triangleCount = static_cast<uint>(indices.size() / 3);
+        if (clusters.size() < 2 || triangleCount == 0)
+        {
+            return;
+        }
+
+        auto triangleCenter = [&](uint triangle, Vector3& normal) {
+            const auto& a = vertices[indices[triangle * 3 + 0]].position;
+            const auto& b = vertices[indices[triangle * 3 + 1]].position;
+            const auto& c = vertices[indices[triangle * 3 + 2]].position;
+            normal        = glm::cross(b - a, c - a); // area weighted
+            return (a + b + c) / 3.f;
+        };
+
+        Vector3 meshCenter(0.f);
+        for (uint t = 0; t < triangleCount; ++t)
+        {
+            Vector3 normal;
+            meshCenter += triangleCenter(t, normal);
+        }
+        meshCenter /= float(triangleCount);
+
+        // clusters facing away from the center are likely to occlude the rest, draw them first
+        struct Cluster
+        {
+            uint  begin;
+            uint  end;
+            float key;
+        };
+        std::vector<Cluster> order;
+        order.reserve(clusters.size());
+        for (size_t i = 0; i < clusters.size(); ++i)
+        {
+            Cluster cluster;
+            cluster.begin = clusters[i];
+            cluster.end   = i + 1 < clusters.size() ? clusters[i + 1] : triangleCount;
+
+            Vector3 center(0.f);
+            Vector3 normal(0.f);
+            for (uint t = cluster.begin; t < cluster.end; ++t)
+            {
+                Vector3 n;
+                center += triangleCenter(t, n);
+                normal += n;
+            }
+            center /= float(cluster.end - cluster.begin);
+            cluster.key = glm::dot(center - meshCenter, normal);
+            order.push_back(cluster);
+        }
+        std::stable_sort(order.begin(), order.end(), [](const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+        std::vector<unsigned int> result;
+        result.reserve(indices.size());
+        for (const auto& cluster : order)
+        {
+            result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+        }
+
+        // the cluster seams cost cache misses, keep the cache order when they cost too many
+        uint vertexCount = static_cast<uint>(vertices.size());
+        if (analyze(result, vertexCount).acmr <= analyze(indices, vertexCount).acmr * threshold)
+        {
+            indices.swap(result);
+        }
+    }
+
+    uint MeshOptimizer::optimizeVertexFetch(std::vector<MeshData::Vertex>& vertices, std::vector<unsigned int>& indices)
+    {
+        const uint                    Unused = 0xFFFFFFFF;
+        std::vector<uint>             remap(vertices.size(), Unused);
+        std::vector<MeshData::Vertex> result;
+        result.reserve(vertices.size());
+        for (auto& index : indices)
+        {
+            if (remap[index] == Unused)
+            {
+                remap[index] = static_cast<uint>(result.size());
+                result.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+        uint removed = static_cast<uint>(vertices.size() - result.size());
+        vertices.swap(result);
+        return removed;
+    }
+
+    MeshOptimizer::Report MeshOptimizer::optimize(std::vector<MeshData::Vertex>& vertices,
+                                                  std::vector<unsigned int>&     indices)
+    {
+        Report report;
+        report.before = analyze(indices, static_cast<uint>(vertices.size()));
+
+        weld(vertices, indices);
+        std::vector<uint> clusters;
+        optimizeVertexCache(indices, static_cast<uint>(vertices.size()), &clusters);
+        optimizeOverdraw(indices, vertices, clusters);
+        report.welded = optimizeVertexFetch(vertices, indices);
+
+        report.after = analyze(indices, static_cast<uint>(vertices.size()));
+        return report;
+    }
+} // namespace Hub
@@ -0,0 +1,60 @@
+#pragma once
+#include "utils.h"
+#include "mesh.h"
+#include <vector>
+
+namespace Hub
+{
+    // Reorders an indexed triangle list for the GPU, run on the imported arrays before they are uploaded:
+    //   weld                  merges bitwise identical vertices, importers split them per face
+    //   optimizeVertexCache   Tipsify (Sander et al. 2007), triangles fan around vertices still in the
+    //                         post-transform cache
+    //   optimizeOverdraw      sorts the Tipsify clusters so outward facing ones come first, as long as the
+    //                         cache efficiency stays within a threshold
+    //   optimizeVertexFetch   renumbers the vertices in first use order, fetches walk the buffer forwards
+    // Nothing here touches GL, the passes are safe to run on the ThreadPool.
+    class MeshOptimizer
+    {
+    public:
+        static constexpr uint CacheSize = 16; // FIFO entries of the simulated post-transform cache
+
+        struct Stats
+        {
+            uint  misses    = 0;
+            uint  triangles = 0;
+            uint  vertices  = 0;   // referenced by at least one triangle
+            float acmr      = 0.f; // misses per triangle, 0.5 is ideal and 3 the worst
+            float atvr      = 0.f; // misses per vertex, 1 is ideal
+        };
+
+        struct Report
+        {
+            uint  welded = 0; // vertices removed by weld and the fetch remap
+            Stats before;
+            Stats after;
+        };
+
+        static Stats analyze(const std::vector<unsigned int>& indices, uint vertexCount, uint cacheSize = CacheSize);
+
+        // returns the number of vertices removed
+        static uint weld(std::vector<MeshData::Vertex>& vertices, std::vector<unsigned int>& indices);
+
+        // clusters, when given, receives the first triangle of every run that starts at a dead end
+        static void optimizeVertexCache(std::vector<unsigned int>& indices,
+                                        uint                       vertexCount,
+                                        std::vector<uint>*         clusters  = nullptr,
+                                        uint                       cacheSize = CacheSize);
+
+        // threshold is the ACMR the new order may reach relative to the input, above it the input is kept
+        static void optimizeOverdraw(std::vector<unsigned int>&           indices,
+                                     const std::vector<MeshData::Vertex>& vertices,
+                                     const std::vector<uint>&             clusters,
+                                     float                                threshold = 1.05f);
+
+        // drops vertices no triangle references, returns the number removed
+        static uint optimizeVertexFetch(std::vector<MeshData::Vertex>& vertices, std::vector<unsigned int>& indices);
+
+        // all four in order
+        static Report optimize(std::vector<MeshData::Vertex>& vertices, std::vector<unsigned int>& indices);
+    };
+} // namespace Hub
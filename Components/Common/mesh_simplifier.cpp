@@ -0,0 +1,270 @@
+#include "mesh_simplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_set>
+
+namespace Hub
+{
+    namespace
+    {
+        // squared distance to a set of planes, weighted by the area of the triangles they came from
+        struct Quadric
+        {
+            double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+            double b0 = 0, b1 = 0, b2 = 0;
+            double c = 0;
+
+            static Quadric fromTriangle(const Vector3& p0, const Vector3& p1, const Vector3& p2)
+            {
+                Quadric q;
+                glm::dvec3 normal = glm::cross(glm::dvec3(p1 - p0), glm::dvec3(p2 - p0));
+                double     area   = glm::length(normal);
+                if (area == 0.0)
+                {
+                    return q;
+                }
+                normal /= area;
+                double d = -glm::dot(normal, glm::dvec3(p0));
+
+                q.a00 = area * normal.x * normal.x;
+                q.a01 = area * normal.x * normal.y;
+                q.a02 = area * normal.x * normal.z;
+                q.a11 = area * normal.y * normal.y;
+                q.a12 = area * normal.y * normal.z;
+                q.a22 = area * normal.z * normal.z;
+                q.b0  = area * normal.x * d;
+                q.b1  = area * normal.y * d;
+                q.b2  = area * normal.z * d;
+                q.c   = area * d * d;
+                return q;
+            }
+
+            void add(const Quadric& q)
+            {
+                a00 += q.a00;
+                a01 += q.a01;
+                a02 += q.a02;
+                a11 += q.a11;
+                a12 += q.a12;
+                a22 += q.a22;
+                b0 += q.b0;
+                b1 += q.b1;
+                b2 += q.b2;
+                c += q.c;
+            }
+
+            double eval(const Vector3& p) const
+            {
+                double x = p.x, y = p.y, z = p.z;
+                double r = a00 * x * x + a11 * y * y + a22 * z * z + 2 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                           2 * (b0 * x + b1 * y + b2 * z) + c;
+                return std::max(r, 0.0);
+            }
+        };
+
+        struct Collapse
+        {
+            uint   from;
+            uint   to;
+            double cost;
+        };
+
+        uint64_t edgeKey(uint a, uint b)
+        {
+            return a < b ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+        }
+    } // namespace
+
+    std::vector<unsigned int> MeshSimplifier::simplify(const std::vector<MeshData::Vertex>& vertices,
+                                                       const std::vector<unsigned int>&     indices,
+                                                       size_t                               targetIndexCount,
+                                                       float                                targetError,
+                                                       float*                               error)
+    {
+        uint                      vertexCount = static_cast<uint>(vertices.size());
+        std::vector<unsigned int> result      = indices;
+        auto position = [&](uint v) -> const Vector3& { return vertices[v].position; };
+
+        // the error of a vertex is measured against the planes of the triangles around it. Area weights make
+        // the sum the integral of the squared distance, which is what gets compared against targetError.
+        std::vector<Quadric> quadrics(vertexCount);
+        std::vector<double>  areas(vertexCount, 0.0);
+        for (size_t i = 0; i < result.size(); i += 3)
+        {
+            Quadric q    = Quadric::fromTriangle(position(result[i]), position(result[i + 1]), position(result[i + 2]));
+            double  area = q.a00 + q.a11 + q.a22; // |n|^2 = 1, so this is the weight
+            for (uint k = 0; k < 3; ++k)
+            {
+                quadrics[result[i + k]].add(q);
+                areas[result[i + k]] += area;
+            }
+        }
+
+        // an edge used by a single triangle is open, its vertices are locked
+        std::vector<bool> locked(vertexCount, false);
+        {
+            std::unordered_set<uint64_t> once;
+            std::unordered_set<uint64_t> shared;
+            for (size_t i = 0; i < result.size(); i += 3)
+            {
+                for (uint k = 0; k < 3; ++k)
+                {
+                    uint64_t key = edgeKey(result[i + k], result[i + (k + 1) % 3]);
+                    if (!once.insert(key).second)
+                    {
+                        shared.insert(key);
+                    }
+                }
+            }
+            for (uint64_t key : once)
+            {
+                if (!shared.count(key))
+                {
+                    locked[key >> 32]        = true;
+                    locked[key & 0xFFFFFFFF] = true;
+                }
+            }
+        }
+
+        // squared distance of moving from onto to, averaged over the area of the planes involved
+        auto cost = [&](uint from, uint to) {
+            Quadric q = quadrics[from];
+            q.add(quadrics[to]);
+            double area = areas[from] + areas[to];
+            return area > 0.0 ? q.eval(position(to)) / area : 0.0;
+        };
+        double maxError   = 0.0;
+        double errorLimit = double(targetError) * targetError;
+
+        // greedy passes: collapse the cheapest edges, at most one collapse around any vertex per pass so the
+        // flip test below sees the current triangles
+        std::vector<uint>     offsets(vertexCount + 1);
+        std::vector<uint>     triangles;
+        std::vector<Collapse> collapses;
+        std::vector<uint>     remap(vertexCount);
+        std::vector<bool>     touched(vertexCount);
+        while (result.size() > targetIndexCount)
+        {
+            // triangles around each vertex
+            std::fill(offsets.begin(), offsets.end(), 0);
+            for (auto index : result)
+            {
+                ++offsets[index + 1];
+            }
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            triangles.resize(result.size());
+            {
+                std::vector<uint> cursor(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < result.size(); ++i)
+                {
+                    triangles[cursor[result[i]]++] = static_cast<uint>(i / 3);
+                }
+            }
+
+            collapses.clear();
+            for (size_t i = 0; i < result.size(); i += 3)
+            {
+                for (uint k = 0; k < 3; ++k)
+                {
+                    uint a = result[i + k];
+                    uint b = result[i + (k + 1) % 3];
+                    for (auto [from, to] : {std::pair(a, b), std::pair(b, a)})
+                    {
+                        if (!locked[from])
+                        {
+                            collapses.push_back({from, to, cost(from, to)});
+                        }
+                    }
+                }
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+                return a.cost < b.cost;
+            });
+
+            // moving from onto to must not turn any of the triangles that stay
+            auto flips = [&](uint from, uint to) {
+                for (uint t = offsets[from]; t < offsets[from + 1]; ++t)
+                {
+                    const unsigned int* triangle = &result[triangles[t] * 3];
+                    if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                    {
+                        continue;
+                    }
+                    Vector3 p[3];
+                    Vector3 q[3];
+                    for (uint k = 0; k < 3; ++k)
+                    {
+                        p[k] = position(triangle[k]);
+                        q[k] = triangle[k] == from ? position(to) : p[k];
+                    }
+                    Vector3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+                    Vector3 after  = glm::cross(q[1] - q[0], q[2] - q[0]);
+                    if (glm::dot(before, after) <= 0.f)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            std::iota(remap.begin(), remap.end(), 0u);
+            std::fill(touched.begin(), touched.end(), false);
+            size_t removeGoal = (result.size() - targetIndexCount + 2) / 3;
+            size_t removed    = 0;
+            for (const auto& collapse : collapses)
+            {
+                if (collapse.cost > errorLimit || removed >= removeGoal)
+                {
+                    break;
+                }
+                if (touched[collapse.from] || touched[collapse.to] || flips(collapse.from, collapse.to))
+                {
+                    continue;
+                }
+
+                remap[collapse.from] = collapse.to;
+                quadrics[collapse.to].add(quadrics[collapse.from]);
+                areas[collapse.to] += areas[collapse.from];
+                maxError = std::max(maxError, collapse.cost);
+                for (uint t = offsets[collapse.from]; t < offsets[collapse.from + 1]; ++t)
+                {
+                    const unsigned int* triangle = &result[triangles[t] * 3];
+                    bool                shared   = false;
+                    for (uint k = 0; k < 3; ++k)
+                    {
+                        touched[triangle[k]] = true;
+                        shared               = shared || triangle[k] == collapse.to;
+                    }
+                    removed += shared ? 1 : 0;
+                }
+            }
+            if (removed == 0)
+            {
+                break;
+            }
+
+            // drop the triangles that lost an edge
+            size_t write = 0;
+            for (size_t i = 0; i < result.size(); i += 3)
+            {
+                uint a = remap[result[i]];
+                uint b = remap[result[i + 1]];
+                uint c = remap[result[i + 2]];
+                if (a != b && b != c && a != c)
+                {
+                    result[write++] = a;
+                    result[write++] = b;
+                    result[write++] = c;
+                }
+            }
+            result.resize(write);
+        }
+
+        if (error)
+        {
+            *error = static_cast<float>(std::sqrt(maxError));
+        }
+        return result;
+    }
+} // namespace Hub
@@ -0,0 +1,22 @@
+#pragma once
+#include "utils.h"
+#include "mesh.h"
+#include <vector>
+
+namespace Hub
+{
+    // Quadric error edge collapse (Garland and Heckbert 1997) restricted to the existing vertices, so every
+    // level of detail indexes the vertex buffer of the full mesh. Vertices on open edges stay where they are,
+    // which also keeps uv and normal seams (split vertices after the weld) from tearing.
+    class MeshSimplifier
+    {
+    public:
+        // indices of a coarser version of the mesh. Stops at targetIndexCount or before a collapse would move the
+        // surface further than targetError, in model units. error receives the largest distance reached.
+        static std::vector<unsigned int> simplify(const std::vector<MeshData::Vertex>& vertices,
+                                                  const std::vector<unsigned int>&     indices,
+                                                  size_t                               targetIndexCount,
+                                                  float                                targetError,
+                                                  float*                               error = nullptr);
+    };
+} // namespace Hub
@@ -1,11 +1,25 @@
 #include "Model.h"
 #include "texture.h"
+#include "cooked_model.h"
+#include "thread_pool.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "vertex_quantizer.h"
+#include <algorithm>
+#include <span>
+#include <unordered_map>
 
 namespace Hub
 {
-    Model::Model(const char* path)
+    Model::Model(const char* path, const MeshData::ImportOptions& options) : importOptions(options)
     {
         loadModel(std::string(path));
+        lodLevels.assign(meshes.size(), 0);
+    }
+
+    const MeshData::Bounds& Model::getBounds() const
+    {
+        return bounds;
     }
 
     void Model::draw(Shader& shader)
@@ -16,88 +30,391 @@ namespace Hub
         }
     }
 
-    void Model::loadModel(std::string path)
+    void Model::draw(Shader& shader, Camera& camera, const Matrix4& transform, float viewportHeight)
     {
-        Assimp::Importer import;
-        const aiScene*   scene = import.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
-        if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+        selectLods(camera, transform, viewportHeight);
+        for (unsigned int i = 0; i < meshes.size(); ++i)
         {
-            std::cout << "ERROR::ASSIMP::" << import.GetErrorString() << std::endl;
-            return;
+            meshes[i].draw(shader, lodLevels[i]);
         }
-        directory = path.substr(0, path.find_last_of('/'));
-        processNode(scene->mRootNode, scene);
     }
 
-    void Model::processNode(aiNode* node, const aiScene* scene)
+    void Model::submit(DrawList&      list,
+                       Shader&        shader,
+                       Camera&        camera,
+                       const Matrix4& transform,
+                       float          viewportHeight,
+                       bool           transparent)
     {
-        // process all the node's meshes (if any)
-        for (unsigned int i = 0; i < node->mNumMeshes; ++i)
+        selectLods(camera, transform, viewportHeight);
+        for (unsigned int i = 0; i < meshes.size(); ++i)
         {
-            aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-            meshes.push_back(processMesh(mesh, scene));
+            list.add(shader, meshes[i], transform, lodLevels[i], transparent);
         }
+    }
 
-        // then do the same for each of its children
-        for (unsigned int i = 0; i < node->mNumChildren; ++i)
+    void Model::setLodThreshold(float pixels, float hysteresis)
+    {
+        lodPixels     = pixels;
+        lodHysteresis = hysteresis;
+    }
+
+    void Model::selectLods(Camera& camera, const Matrix4& transform, float viewportHeight)
+    {
+        // world units to pixels at distance 1
+        float   pixelsPerUnit = viewportHeight / (2.f * std::tan(glm::radians(camera.getFov()) * 0.5f));
+        float   scale         = std::max({glm::length(Vector3(transform[0])),
+                                          glm::length(Vector3(transform[1])),
+                                          glm::length(Vector3(transform[2]))});
+        Vector3 eye           = camera.getPosition();
+
+        for (unsigned int i = 0; i < meshes.size(); ++i)
         {
-            processNode(node->mChildren[i], scene);
+            auto& mesh = meshes[i];
+            if (mesh.lods.size() < 2)
+            {
+                lodLevels[i] = 0;
+                continue;
+            }
+
+            // distance to the bounding sphere, the nearest the mesh can be
+            Vector3 center   = Vector3(transform * Vector4((mesh.bounds.min + mesh.bounds.max) * 0.5f, 1.f));
+            float   radius   = glm::length(mesh.bounds.max - mesh.bounds.min) * 0.5f * scale;
+            float   distance = std::max(glm::length(center - eye) - radius, 1e-3f);
+            auto    pixels   = [&](uint level) { return mesh.lods[level].error * scale / distance * pixelsPerUnit; };
+
+            uint level = std::min<uint>(lodLevels[i], static_cast<uint>(mesh.lods.size() - 1));
+            while (level > 0 && pixels(level) > lodPixels)
+            {
+                --level;
+            }
+            while (level + 1 < mesh.lods.size() && pixels(level + 1) <= lodPixels * (1.f - lodHysteresis))
+            {
+                ++level;
+            }
+            lodLevels[i] = level;
         }
     }
 
-    Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
+    namespace
     {
-        std::vector<MeshData::Vertex>  vertices;
-        std::vector<unsigned int>      indices;
-        std::vector<MeshData::Texture> textures;
-        for (unsigned int i = 0; i < mesh->mNumVertices; ++i)
+        bool& printImportStats()
+        {
+            static bool s_print = false;
+            return s_print;
+        }
+
+        struct MeshArrays
+        {
+            std::vector<MeshData::Vertex> vertices;
+            std::vector<unsigned int>     indices;
+            MeshData::Bounds              bounds;
+            std::vector<unsigned char>    packed; // vertices in the model's vertex format, empty for Full
+            VertexQuantizer::Error        error;
+            std::vector<MeshData::Lod>    lods;   // levels after the full mesh are appended to indices
+
+            std::span<const unsigned char> vertexBytes() const
+            {
+                if (!packed.empty())
+                {
+                    return packed;
+                }
+                return {reinterpret_cast<const unsigned char*>(vertices.data()),
+                        vertices.size() * sizeof(MeshData::Vertex)};
+            }
+        };
+
+        // sizes are known up front, so each array is allocated once and written in place
+        MeshArrays convertMesh(const aiMesh& mesh)
         {
-            MeshData::Vertex vertex;
-            vertex.position = Vector3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
-            vertex.normal   = Vector3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
-            if (mesh->mTextureCoords[0])
+            MeshArrays arrays;
+            arrays.vertices.resize(mesh.mNumVertices);
+            const aiVector3D* texCoords = mesh.mTextureCoords[0];
+            for (unsigned int i = 0; i < mesh.mNumVertices; ++i)
             {
-                vertex.texCoords = Vector2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+                auto& vertex    = arrays.vertices[i];
+                vertex.position = Vector3(mesh.mVertices[i].x, mesh.mVertices[i].y, mesh.mVertices[i].z);
+                vertex.normal   = mesh.mNormals ? Vector3(mesh.mNormals[i].x, mesh.mNormals[i].y, mesh.mNormals[i].z)
+                                                : Vector3(0.f, 0.f, 0.f);
+                vertex.texCoords = texCoords ? Vector2(texCoords[i].x, texCoords[i].y) : Vector2(0.f, 0.f);
+                arrays.bounds.add(vertex.position);
             }
-            else
+
+            // triangulated, faces have at most 3 indices (points and lines fewer)
+            arrays.indices.reserve(static_cast<size_t>(mesh.mNumFaces) * 3);
+            for (unsigned int i = 0; i < mesh.mNumFaces; ++i)
+            {
+                const aiFace& face = mesh.mFaces[i];
+                arrays.indices.insert(arrays.indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+            }
+            return arrays;
+        }
+
+        // each level halves the triangles of the full mesh until the error target stops the simplifier. Levels
+        // are simplified from the full mesh, so their error is measured against it.
+        void buildLods(MeshArrays& arrays, const MeshData::ImportOptions& options)
+        {
+            std::vector<unsigned int> full        = arrays.indices;
+            Vector3                   extent      = arrays.bounds.max - arrays.bounds.min;
+            float                     targetError = options.lodError * glm::length(extent);
+            uint                      vertexCount = static_cast<uint>(arrays.vertices.size());
+
+            arrays.lods.push_back({0, static_cast<uint>(full.size()), 0.f});
+            uint lodCount = std::min(options.lodCount, MeshData::MaxLods);
+            for (uint level = 1; level < lodCount; ++level)
+            {
+                size_t target = (full.size() >> level) / 3 * 3;
+                float  error  = 0.f;
+                auto   lod    = MeshSimplifier::simplify(arrays.vertices, full, target, targetError, &error);
+                // a level barely smaller than the previous one is not worth its memory
+                if (lod.empty() || lod.size() * 10 > size_t(arrays.lods.back().indexCount) * 9)
+                {
+                    break;
+                }
+                MeshOptimizer::optimizeVertexCache(lod, vertexCount);
+                arrays.lods.push_back(
+                    {static_cast<uint>(arrays.indices.size()), static_cast<uint>(lod.size()), error});
+                arrays.indices.insert(arrays.indices.end(), lod.begin(), lod.end());
+            }
+        }
+
+        // one line per import, ACMR and ATVR over all meshes of the model
+        void printOptimization(const std::string& path, const std::vector<MeshOptimizer::Report>& reports)
+        {
+            MeshOptimizer::Stats before;
+            MeshOptimizer::Stats after;
+            uint                 welded = 0;
+            for (const auto& report : reports)
+            {
+                before.misses += report.before.misses;
+                before.triangles += report.before.triangles;
+                before.vertices += report.before.vertices;
+                after.misses += report.after.misses;
+                after.triangles += report.after.triangles;
+                after.vertices += report.after.vertices;
+                welded += report.welded;
+            }
+            if (before.triangles == 0)
             {
-                vertex.texCoords = Vector2(0.f, 0.f);
+                return;
             }
-            vertices.push_back(vertex);
+            std::cout << "Model: " << path << " ACMR " << float(before.misses) / before.triangles << " -> "
+                      << float(after.misses) / after.triangles << ", ATVR " << float(before.misses) / before.vertices
+                      << " -> " << float(after.misses) / after.vertices << ", " << welded << " vertices welded"
+                      << std::endl;
         }
-        // process indices
-        for (unsigned int i = 0; i < mesh->mNumFaces; ++i)
+
+        void printLods(const std::string& path, const std::vector<MeshArrays>& converted)
         {
-            aiFace face = mesh->mFaces[i];
-            for (unsigned int j = 0; j < face.mNumIndices; ++j)
+            uint triangles[MeshData::MaxLods] = {};
+            for (const auto& arrays : converted)
             {
-                indices.push_back(face.mIndices[j]);
+                for (size_t level = 0; level < arrays.lods.size(); ++level)
+                {
+                    triangles[level] += arrays.lods[level].indexCount / 3;
+                }
             }
+            std::cout << "Model: " << path << " levels of detail";
+            for (uint level = 0; level < MeshData::MaxLods && triangles[level] > 0; ++level)
+            {
+                std::cout << (level == 0 ? " " : " / ") << triangles[level];
+            }
+            std::cout << " triangles" << std::endl;
         }
 
-        // process materials
-        if (mesh->mMaterialIndex >= 0)
+        void printQuantization(const std::string&               path,
+                               MeshData::VertexFormat::format_t format,
+                               const std::vector<MeshArrays>&   converted)
         {
-            aiMaterial*                    material = scene->mMaterials[mesh->mMaterialIndex];
-            std::vector<MeshData::Texture> diffuseMaps =
-                loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
-            textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
-            std::vector<MeshData::Texture> specularMaps =
-                loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
-            textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
+            VertexQuantizer::Error error;
+            for (const auto& arrays : converted)
+            {
+                error.position  = std::max(error.position, arrays.error.position);
+                error.normal    = std::max(error.normal, arrays.error.normal);
+                error.texCoords = std::max(error.texCoords, arrays.error.texCoords);
+            }
+            std::cout << "Model: " << path << " " << VertexQuantizer::getName(format) << " vertices, "
+                      << MeshData::layoutOf(format).getStride() << " bytes, max error position " << error.position
+                      << ", normal " << error.normal << " deg, texCoords " << error.texCoords << std::endl;
         }
+    } // namespace
 
-        return Mesh(vertices, indices, textures);
+    void Model::setPrintImportStats(bool print)
+    {
+        printImportStats() = print;
     }
 
-    static SPTexture TextureFromFile(const std::string& filePath)
+    void Model::loadModel(std::string path)
     {
-        auto texture = Texture::create(filePath.c_str());
-        texture->setWrapping(Wrapping::axis_t::S, Wrapping::wrapping_t::Repeat);
-        texture->setWrapping(Wrapping::axis_t::T, Wrapping::wrapping_t::Repeat);
-        texture->setFilter(Filter::operator_t::Mag, Filter::filter_t::Linear);
-        texture->setFilter(Filter::operator_t::Min, Filter::filter_t::LinearMipmapLinear);
-        return texture;
+        directory = path.substr(0, path.find_last_of('/'));
+
+        // the cooked file skips Assimp and the conversion, it is written after every import from source
+        auto cookedPath = CookedModel::pathFor(path);
+        auto cooked     = CookedModel::open(cookedPath, path);
+        if (cooked && cooked->getImportOptions() == importOptions)
+        {
+            loadCooked(*cooked);
+            return;
+        }
+
+        Assimp::Importer import;
+        const aiScene*   scene = import.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
+        if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
+        {
+            std::cout << "ERROR::ASSIMP::" << import.GetErrorString() << std::endl;
+            return;
+        }
+
+        std::vector<const aiMesh*> sources;
+        processNode(scene->mRootNode, scene, sources);
+
+        // the aiMeshes are independent, convert, optimize, simplify and pack them on the workers. Nothing here
+        // touches GL.
+        auto                               vertexFormat = importOptions.vertexFormat;
+        std::vector<MeshArrays>            converted(sources.size());
+        std::vector<MeshOptimizer::Report> reports(sources.size());
+        ThreadPool::parallelFor(static_cast<uint>(sources.size()), [&](uint i) {
+            auto& arrays = converted[i];
+            arrays       = convertMesh(*sources[i]);
+            reports[i]   = MeshOptimizer::optimize(arrays.vertices, arrays.indices);
+            buildLods(arrays, importOptions);
+            if (vertexFormat != MeshData::VertexFormat::Full)
+            {
+                arrays.error = VertexQuantizer::pack(vertexFormat, arrays.vertices, arrays.bounds, arrays.packed);
+            }
+        });
+
+        uint vertexCount  = 0;
+        uint indexCount   = 0;
+        bool shortIndices = true; // indices are per mesh, 16 bit as long as no mesh has more than 65536 vertices
+        for (const auto& arrays : converted)
+        {
+            vertexCount += static_cast<uint>(arrays.vertices.size());
+            indexCount += static_cast<uint>(arrays.indices.size());
+            shortIndices = shortIndices && arrays.vertices.size() <= 65536;
+        }
+        if (printImportStats())
+        {
+            printOptimization(path, reports);
+            printLods(path, converted);
+        }
+        if (printImportStats() && vertexFormat != MeshData::VertexFormat::Full)
+        {
+            printQuantization(path, vertexFormat, converted);
+        }
+        geometryPool = GeometryPool::create(MeshData::layoutOf(vertexFormat),
+                                            vertexCount,
+                                            indexCount,
+                                            shortIndices ? Type::UnsignedShort : Type::UnsignedInt);
+
+        // texture files decode on the workers while the geometry is uploaded, the textures are created at the end
+        std::vector<std::vector<MeshData::Texture>> textures(sources.size());
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            if (sources[i]->mMaterialIndex < scene->mNumMaterials)
+            {
+                aiMaterial*                    material = scene->mMaterials[sources[i]->mMaterialIndex];
+                std::vector<MeshData::Texture> diffuseMaps =
+                    loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
+                textures[i].insert(textures[i].end(), diffuseMaps.begin(), diffuseMaps.end());
+                std::vector<MeshData::Texture> specularMaps =
+                    loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
+                textures[i].insert(textures[i].end(), specularMaps.begin(), specularMaps.end());
+            }
+            requestTextures(textures[i]);
+        }
+
+        std::vector<CookedModel::CookedMesh> cookedMeshes;
+        cookedMeshes.reserve(converted.size());
+        for (size_t i = 0; i < converted.size(); ++i)
+        {
+            const auto& arrays = converted[i];
+            cookedMeshes.push_back({arrays.vertexBytes(),
+                                    static_cast<uint>(arrays.vertices.size()),
+                                    arrays.indices,
+                                    {},
+                                    arrays.bounds,
+                                    arrays.lods,
+                                    textures[i]});
+        }
+        CookedModel::write(cookedPath, path, importOptions, cookedMeshes);
+
+        // uploads on the render thread, full vertices are moved into the meshes, packed ones only uploaded
+        meshes.reserve(sources.size());
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            auto& arrays = converted[i];
+            if (vertexFormat == MeshData::VertexFormat::Full)
+            {
+                meshes.emplace_back(
+                    std::move(arrays.vertices), std::move(arrays.indices), std::move(textures[i]), geometryPool);
+            }
+            else
+            {
+                meshes.emplace_back(arrays.packed.data(),
+                                    arrays.vertices.size(),
+                                    vertexFormat,
+                                    arrays.indices.data(),
+                                    arrays.indices.size(),
+                                    Type::UnsignedInt,
+                                    std::move(textures[i]),
+                                    geometryPool);
+            }
+            meshes.back().bounds = arrays.bounds;
+            meshes.back().lods   = std::move(arrays.lods);
+            bounds.add(arrays.bounds);
+        }
+        resolveTextures();
+    }
+
+    void Model::loadCooked(const CookedModel& cooked)
+    {
+        geometryPool = GeometryPool::create(MeshData::layoutOf(cooked.getVertexFormat()),
+                                            cooked.getVertexCount(),
+                                            cooked.getIndexCount(),
+                                            cooked.getIndexType());
+        bounds = cooked.getBounds();
+
+        for (uint i = 0; i < cooked.getMeshCount(); ++i)
+        {
+            requestTextures(cooked.getMesh(i).textures);
+        }
+
+        // the streams are uploaded from the mapped pages, nothing is copied on the CPU side
+        meshes.reserve(cooked.getMeshCount());
+        for (uint i = 0; i < cooked.getMeshCount(); ++i)
+        {
+            auto        source  = cooked.getMesh(i);
+            const void* indices = cooked.getIndexType() == Type::UnsignedShort
+                                      ? static_cast<const void*>(source.shortIndices.data())
+                                      : static_cast<const void*>(source.indices.data());
+            meshes.emplace_back(source.vertices.data(),
+                                source.vertexCount,
+                                cooked.getVertexFormat(),
+                                indices,
+                                std::max(source.indices.size(), source.shortIndices.size()),
+                                cooked.getIndexType(),
+                                std::move(source.textures),
+                                geometryPool);
+            meshes.back().bounds = source.bounds;
+            meshes.back().lods   = std::move(source.lods);
+        }
+        resolveTextures();
+    }
+
+    void Model::processNode(aiNode* node, const aiScene* scene, std::vector<const aiMesh*>& sources)
+    {
+        // process all the node's meshes (if any)
+        for (unsigned int i = 0; i < node->mNumMeshes; ++i)
+        {
+            sources.push_back(scene->mMeshes[node->mMeshes[i]]);
+        }
+
+        // then do the same for each of its children
+        for (unsigned int i = 0; i < node->mNumChildren; ++i)
+        {
+            processNode(node->mChildren[i], scene, sources);
+        }
     }
 
     std::vector<MeshData::Texture>
@@ -108,24 +425,52 @@ namespace Hub
         {
             aiString str;
             mat->GetTexture(type, i, &str);
-            auto path = std::string(str.C_Str());
-            if (textureLoadedMap.find(path) != textureLoadedMap.end())
-            {
-                textures.push_back(textureLoadedMap[path]);
-            }
-            else
+            MeshData::Texture texture;
+            texture.type = typeName;
+            texture.path = str.C_Str();
+            textures.push_back(texture);
+        }
+        return textures;
+    }
+
+    void Model::requestTextures(const std::vector<MeshData::Texture>& textures)
+    {
+        if (!textureLoader)
+        {
+            textureLoader = TextureLoader::create([](Texture& texture) {
+                texture.setWrapping(Wrapping::axis_t::S, Wrapping::wrapping_t::Repeat);
+                texture.setWrapping(Wrapping::axis_t::T, Wrapping::wrapping_t::Repeat);
+                texture.setFilter(Filter::operator_t::Mag, Filter::filter_t::Linear);
+                texture.setFilter(Filter::operator_t::Min, Filter::filter_t::LinearMipmapLinear);
+            });
+        }
+        // the loader skips files already requested, materials sharing a texture share one upload
+        for (const auto& texture : textures)
+        {
+            textureLoader->request(directory + "/" + texture.path);
+        }
+    }
+
+    void Model::resolveTextures()
+    {
+        if (!textureLoader)
+        {
+            return;
+        }
+        textureLoader->finish();
+        // meshes using the same textures share one material, drawing them in a row binds the textures once
+        std::unordered_map<uint64_t, SPMaterial> materials;
+        for (auto& mesh : meshes)
+        {
+            for (auto& texture : mesh.textures)
             {
-                MeshData::Texture texture;
-                auto              filePath = directory + "/" + path;
-                texture.ptr                = TextureFromFile(filePath);
-                /*texture.id = texture.ptr->getID();*/
-                texture.type = typeName;
-                texture.path = path;
-                textures.push_back(texture);
-                textureLoadedMap[path] = texture;
+                texture.ptr = textureLoader->get(directory + "/" + texture.path);
             }
+            auto material = Material::create(mesh.textures);
+            mesh.material = materials.emplace(material->getHash(), material).first->second;
         }
-        return textures;
+        // keeps nothing alive, the meshes own the textures now
+        textureLoader = nullptr;
     }
 
 } // namespace Hub
\ No newline at end of file
@@ -1,31 +1,71 @@
 #pragma once
 #include "shader.h"
 #include "mesh.h"
+#include "draw_list.h"
+#include "texture_loader.h"
+#include "camera.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
-#include <unordered_map>
-
 namespace Hub
 {
+    class CookedModel;
+
     class Model
     {
     public:
-        Model(const char* path);
+        // a vertexFormat other than Full packs the vertices at import, shaders need
+        // MeshData::definesFor(options.vertexFormat)
+        Model(const char* path, const MeshData::ImportOptions& options = {});
+        // every mesh at full detail
         void draw(Shader& shader);
+        // picks the level of detail of each mesh from its error projected to the screen. transform is the model
+        // matrix the shader uses, viewportHeight in pixels. The chosen levels are kept for the hysteresis, so
+        // instances drawn with very different transforms want a Model each.
+        void draw(Shader& shader, Camera& camera, const Matrix4& transform, float viewportHeight);
+        // same level selection as draw, the meshes are added to list instead of drawn. list sorts them with the
+        // meshes of other models by program, material and depth.
+        void submit(DrawList&      list,
+                    Shader&        shader,
+                    Camera&        camera,
+                    const Matrix4& transform,
+                    float          viewportHeight,
+                    bool           transparent = false);
+
+        // a level is used while its error covers at most pixels on screen. A coarser level is only taken once its
+        // error drops below pixels * (1 - hysteresis), which keeps meshes near the threshold from flickering.
+        void setLodThreshold(float pixels, float hysteresis = 0.25f);
+
+        // imports from source print what the conversion did to the meshes, off by default
+        static void setPrintImportStats(bool print);
+
+        const MeshData::Bounds& getBounds() const;
 
     private:
         // model data
         std::vector<Mesh> meshes;
         std::string       directory;
+        SPGeometryPool    geometryPool; // all meshes of the model share one vertex and index buffer
+        MeshData::Bounds  bounds;
+
+        MeshData::ImportOptions importOptions;
+        std::vector<uint>       lodLevels; // level drawn last per mesh
+        float                   lodPixels     = 1.f;
+        float                   lodHysteresis = 0.25f;
 
+        // prefers the cooked .hubmesh next to path when it is up to date, otherwise imports and cooks
         void loadModel(std::string path);
-        void processNode(aiNode* node, const aiScene* scene);
-        Mesh processMesh(aiMesh* mesh, const aiScene* scene);
+        void loadCooked(const CookedModel& cooked);
+        void selectLods(Camera& camera, const Matrix4& transform, float viewportHeight);
+        // meshes in node order, the order draw() draws them in
+        void processNode(aiNode* node, const aiScene* scene, std::vector<const aiMesh*>& sources);
 
+        // references only, the files are requested from textureLoader and the pointers filled in by resolveTextures
         std::vector<MeshData::Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName);
-        std::unordered_map<std::string, MeshData::Texture> textureLoadedMap;
+        void                           requestTextures(const std::vector<MeshData::Texture>& textures);
+        void                           resolveTextures();
+        SPTextureLoader                textureLoader;
     };
 } // namespace Hub
\ No newline at end of file
@@ -0,0 +1,321 @@
+#include "offset_allocator.h"
+#include <bit>
+
+namespace Hub
+{
+    namespace
+    {
+        // sizes are binned as a small float: 5 bit exponent, 3 bit mantissa
+        const uint MantissaBits  = 3;
+        const uint MantissaValue = 1 << MantissaBits;
+        const uint MantissaMask  = MantissaValue - 1;
+
+        // bin whose sizes are all >= size, used to search for a fit
+        uint toBinRoundUp(uint size)
+        {
+            uint exponent = 0;
+            uint mantissa = 0;
+            if (size < MantissaValue)
+            {
+                mantissa = size;
+            }
+            else
+            {
+                uint highestBit  = 31 - std::countl_zero(size);
+                uint mantissaBit = highestBit - MantissaBits;
+                exponent         = mantissaBit + 1;
+                mantissa         = (size >> mantissaBit) & MantissaMask;
+                if (size & ((1u << mantissaBit) - 1))
+                {
+                    ++mantissa; // may carry into the exponent, which is what we want
+                }
+            }
+            return (exponent << MantissaBits) + mantissa;
+        }
+
+        // bin a free region of size belongs to
+        uint toBinRoundDown(uint size)
+        {
+            uint exponent = 0;
+            uint mantissa = 0;
+            if (size < MantissaValue)
+            {
+                mantissa = size;
+            }
+            else
+            {
+                uint highestBit  = 31 - std::countl_zero(size);
+                uint mantissaBit = highestBit - MantissaBits;
+                exponent         = mantissaBit + 1;
+                mantissa         = (size >> mantissaBit) & MantissaMask;
+            }
+            return (exponent << MantissaBits) | mantissa;
+        }
+
+        uint binToSize(uint bin)
+        {
+            uint exponent = bin >> MantissaBits;
+            uint mantissa = bin & MantissaMask;
+            if (exponent == 0)
+            {
+                return mantissa;
+            }
+            return (mantissa | MantissaValue) << (exponent - 1);
+        }
+
+        uint lowestSetBitAfter(uint mask, uint start)
+        {
+            if (start >= 32)
+            {
+                return OffsetAllocator::NoSpace;
+            }
+            uint bits = mask & ~((1u << start) - 1);
+            return bits == 0 ? OffsetAllocator::NoSpace : static_cast<uint>(std::countr_zero(bits));
+        }
+    } // namespace
+
+    OffsetAllocator::OffsetAllocator(uint size) : _size(size)
+    {
+        reset();
+    }
+
+    OffsetAllocator::Allocation OffsetAllocator::allocate(uint size)
+    {
+        if (size == 0)
+        {
+            return Allocation();
+        }
+
+        // smallest bin that is guaranteed to fit, then the first non empty one above it
+        uint minBin     = toBinRoundUp(size);
+        uint minTopBin  = minBin >> MantissaBits;
+        uint minLeafBin = minBin & MantissaMask;
+
+        uint topBin  = minTopBin;
+        uint leafBin = NoSpace;
+        if (topBin < TopBins && (_usedBinsTop & (1u << topBin)))
+        {
+            leafBin = lowestSetBitAfter(_usedBins[topBin], minLeafBin);
+        }
+        if (leafBin == NoSpace)
+        {
+            topBin = lowestSetBitAfter(_usedBinsTop, minTopBin + 1);
+            if (topBin == NoSpace)
+            {
+                return Allocation();
+            }
+            leafBin = std::countr_zero(static_cast<uint>(_usedBins[topBin]));
+        }
+
+        uint binIndex  = (topBin << MantissaBits) | leafBin;
+        uint nodeIndex = _binIndices[binIndex];
+
+        Node& node      = _nodes[nodeIndex];
+        uint  totalSize = node.size;
+        node.size       = size;
+        node.used       = true;
+
+        _binIndices[binIndex] = node.binListNext;
+        if (node.binListNext != Unused)
+        {
+            _nodes[node.binListNext].binListPrev = Unused;
+        }
+        _freeStorage -= totalSize;
+        if (_binIndices[binIndex] == Unused)
+        {
+            _usedBins[topBin] &= ~(1u << leafBin);
+            if (_usedBins[topBin] == 0)
+            {
+                _usedBinsTop &= ~(1u << topBin);
+            }
+        }
+
+        // put the tail back as a new free region right after the allocation
+        uint remainder = totalSize - size;
+        if (remainder > 0)
+        {
+            uint offset       = _nodes[nodeIndex].offset + size;
+            uint newNodeIndex = insertNodeIntoBin(remainder, offset);
+
+            Node& allocated = _nodes[nodeIndex];
+            if (allocated.neighborNext != Unused)
+            {
+                _nodes[allocated.neighborNext].neighborPrev = newNodeIndex;
+            }
+            _nodes[newNodeIndex].neighborPrev = nodeIndex;
+            _nodes[newNodeIndex].neighborNext = allocated.neighborNext;
+            allocated.neighborNext            = newNodeIndex;
+        }
+
+        return {_nodes[nodeIndex].offset, nodeIndex};
+    }
+
+    void OffsetAllocator::free(Allocation allocation)
+    {
+        if (!allocation.isValid() || allocation.node >= _nodes.size() || !_nodes[allocation.node].used)
+        {
+            return;
+        }
+
+        uint nodeIndex = allocation.node;
+        Node node      = _nodes[nodeIndex];
+        uint offset    = node.offset;
+        uint size      = node.size;
+
+        // merge with free neighbours
+        if (node.neighborPrev != Unused && !_nodes[node.neighborPrev].used)
+        {
+            const Node& prev = _nodes[node.neighborPrev];
+            offset           = prev.offset;
+            size += prev.size;
+            uint prevIndex    = node.neighborPrev;
+            node.neighborPrev = prev.neighborPrev;
+            removeNodeFromBin(prevIndex);
+        }
+        if (node.neighborNext != Unused && !_nodes[node.neighborNext].used)
+        {
+            const Node& next = _nodes[node.neighborNext];
+            size += next.size;
+            uint nextIndex    = node.neighborNext;
+            node.neighborNext = next.neighborNext;
+            removeNodeFromBin(nextIndex);
+        }
+        releaseNode(nodeIndex);
+
+        uint combinedIndex                 = insertNodeIntoBin(size, offset);
+        _nodes[combinedIndex].neighborPrev = node.neighborPrev;
+        _nodes[combinedIndex].neighborNext = node.neighborNext;
+        if (node.neighborPrev != Unused)
+        {
+            _nodes[node.neighborPrev].neighborNext = combinedIndex;
+        }
+        if (node.neighborNext != Unused)
+        {
+            _nodes[node.neighborNext].neighborPrev = combinedIndex;
+        }
+    }
+
+    void OffsetAllocator::reset()
+    {
+        _freeStorage = 0;
+        _usedBinsTop = 0;
+        _usedBins.fill(0);
+        _binIndices.fill(Unused);
+        _nodes.clear();
+        _freeNodes.clear();
+        if (_size > 0)
+        {
+            insertNodeIntoBin(_size, 0);
+        }
+    }
+
+    uint OffsetAllocator::getSize() const
+    {
+        return _size;
+    }
+
+    uint OffsetAllocator::getAllocationSize(Allocation allocation) const
+    {
+        if (!allocation.isValid() || allocation.node >= _nodes.size())
+        {
+            return 0;
+        }
+        return _nodes[allocation.node].size;
+    }
+
+    OffsetAllocator::Report OffsetAllocator::getReport() const
+    {
+        Report report;
+        report.totalFree = _freeStorage;
+        if (_usedBinsTop != 0)
+        {
+            uint topBin        = 31 - std::countl_zero(_usedBinsTop);
+            uint leafBin       = 31 - std::countl_zero(static_cast<uint>(_usedBins[topBin]));
+            report.largestFree = binToSize((topBin << MantissaBits) | leafBin);
+        }
+        return report;
+    }
+
+    uint OffsetAllocator::insertNodeIntoBin(uint size, uint offset)
+    {
+        uint binIndex = toBinRoundDown(size);
+        uint topBin   = binIndex >> MantissaBits;
+        uint leafBin  = binIndex & MantissaMask;
+
+        if (_binIndices[binIndex] == Unused)
+        {
+            _usedBins[topBin] |= 1u << leafBin;
+            _usedBinsTop |= 1u << topBin;
+        }
+
+        uint head      = _binIndices[binIndex];
+        uint nodeIndex = newNode();
+
+        Node& node       = _nodes[nodeIndex];
+        node.offset      = offset;
+        node.size        = size;
+        node.binListNext = head;
+        if (head != Unused)
+        {
+            _nodes[head].binListPrev = nodeIndex;
+        }
+        _binIndices[binIndex] = nodeIndex;
+        _freeStorage += size;
+        return nodeIndex;
+    }
+
+    void OffsetAllocator::removeNodeFromBin(uint nodeIndex)
+    {
+        const Node& node = _nodes[nodeIndex];
+        if (node.binListPrev != Unused)
+        {
+            _nodes[node.binListPrev].binListNext = node.binListNext;
+            if (node.binListNext != Unused)
+            {
+                _nodes[node.binListNext].binListPrev = node.binListPrev;
+            }
+        }
+        else
+        {
+            // head of its bin
+            uint binIndex = toBinRoundDown(node.size);
+            uint topBin   = binIndex >> MantissaBits;
+            uint leafBin  = binIndex & MantissaMask;
+
+            _binIndices[binIndex] = node.binListNext;
+            if (node.binListNext != Unused)
+            {
+                _nodes[node.binListNext].binListPrev = Unused;
+            }
+            if (_binIndices[binIndex] == Unused)
+            {
+                _usedBins[topBin] &= ~(1u << leafBin);
+                if (_usedBins[topBin] == 0)
+                {
+                    _usedBinsTop &= ~(1u << topBin);
+                }
+            }
+        }
+        _freeStorage -= node.size;
+        releaseNode(nodeIndex);
+    }
+
+    uint OffsetAllocator::newNode()
+    {
+        if (_freeNodes.empty())
+        {
+            _nodes.emplace_back();
+            return static_cast<uint>(_nodes.size() - 1);
+        }
+        uint nodeIndex = _freeNodes.back();
+        _freeNodes.pop_back();
+        _nodes[nodeIndex] = Node();
+        return nodeIndex;
+    }
+
+    void OffsetAllocator::releaseNode(uint nodeIndex)
+    {
+        _nodes[nodeIndex].used = false;
+        _freeNodes.push_back(nodeIndex);
+    }
+} // namespace Hub
@@ -0,0 +1,76 @@
+#pragma once
+#include "utils.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Hub
+{
+    // Two-level segregated fit allocator over an abstract range [0, size), it only hands out offsets and never
+    // touches memory, so it can sub-allocate GPU buffers in any unit (bytes, vertices, indices).
+    // Free regions are kept in 256 size classes (a tiny float with 3 mantissa bits), found with two bitmask
+    // scans, and coalesced with their neighbours on free. allocate and free are O(1).
+    class OffsetAllocator
+    {
+    public:
+        static constexpr uint NoSpace = 0xFFFFFFFF;
+
+        struct Allocation
+        {
+            uint offset = NoSpace;
+            uint node   = NoSpace; // internal, needed to free
+
+            bool isValid() const
+            {
+                return offset != NoSpace;
+            }
+        };
+
+        struct Report
+        {
+            uint totalFree   = 0;
+            uint largestFree = 0; // rounded down to its size class
+        };
+
+        explicit OffsetAllocator(uint size);
+
+        Allocation allocate(uint size);
+        void       free(Allocation allocation);
+        void       reset();
+
+        uint   getSize() const;
+        uint   getAllocationSize(Allocation allocation) const;
+        Report getReport() const;
+
+    private:
+        static constexpr uint TopBins     = 32;
+        static constexpr uint BinsPerLeaf = 8;
+        static constexpr uint LeafBins    = TopBins * BinsPerLeaf;
+        static constexpr uint Unused      = 0xFFFFFFFF;
+
+        struct Node
+        {
+            uint offset       = 0;
+            uint size         = 0;
+            uint binListPrev  = Unused;
+            uint binListNext  = Unused;
+            uint neighborPrev = Unused;
+            uint neighborNext = Unused;
+            bool used         = false;
+        };
+
+        uint insertNodeIntoBin(uint size, uint offset);
+        void removeNodeFromBin(uint nodeIndex);
+        uint newNode();
+        void releaseNode(uint nodeIndex);
+
+        uint _size;
+        uint _freeStorage = 0;
+
+        uint                         _usedBinsTop = 0;
+        std::array<uint8_t, TopBins> _usedBins;
+        std::array<uint, LeafBins>   _binIndices;
+        std::vector<Node>            _nodes;
+        std::vector<uint>            _freeNodes;
+    };
+} // namespace Hub
@@ -0,0 +1,208 @@
+#include "program_cache.h"
+#include "gl_extensions.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Hub
+{
+    namespace
+    {
+        const uint32_t CacheMagic   = 0x50425548; // "HUBP"
+        const uint32_t CacheVersion = 1;
+
+        struct Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t format;
+            uint32_t length;
+        };
+
+        struct Cache
+        {
+            std::string         directory = "./shader_cache";
+            ProgramCache::Stats stats;
+        };
+
+        Cache& cache()
+        {
+            static Cache s_cache;
+            return s_cache;
+        }
+
+        uint64_t fnv1a(uint64_t hash, std::string_view data)
+        {
+            for (unsigned char c : data)
+            {
+                hash ^= c;
+                hash *= 1099511628211ull;
+            }
+            // separator, so ("ab", "c") and ("a", "bc") differ
+            hash ^= 0xFF;
+            hash *= 1099511628211ull;
+            return hash;
+        }
+
+        std::string glString(GLenum name)
+        {
+            auto value = reinterpret_cast<const char*>(glGetString(name));
+            return value ? value : "";
+        }
+
+        std::filesystem::path pathOf(uint64_t key)
+        {
+            char name[32];
+            std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+            return std::filesystem::path(cache().directory) / name;
+        }
+
+        double elapsed(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        bool linkStatus(GLuint program)
+        {
+            GLint success = GL_FALSE;
+            glGetProgramiv(program, GL_LINK_STATUS, &success);
+            return success == GL_TRUE;
+        }
+
+        // false when there is no binary for key or the driver rejects it
+        bool load(GLuint program, uint64_t key)
+        {
+            std::ifstream file(pathOf(key), std::ios::binary);
+            if (!file)
+            {
+                return false;
+            }
+
+            Header header{};
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+            bool valid = file && header.magic == CacheMagic && header.version == CacheVersion && header.length > 0;
+            std::vector<char> binary(valid ? header.length : 0);
+            file.read(binary.data(), binary.size());
+            valid = valid && file;
+            file.close();
+
+            if (valid)
+            {
+                glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+                if (linkStatus(program))
+                {
+                    return true;
+                }
+            }
+            ++cache().stats.rejected;
+            std::error_code error;
+            std::filesystem::remove(pathOf(key), error);
+            return false;
+        }
+
+        void store(GLuint program, uint64_t key)
+        {
+            GLint length = 0;
+            glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+            if (length <= 0)
+            {
+                return;
+            }
+            Header            header{CacheMagic, CacheVersion, 0, static_cast<uint32_t>(length)};
+            std::vector<char> binary(length);
+            GLenum            format = 0;
+            glGetProgramBinary(program, length, nullptr, &format, binary.data());
+            header.format = format;
+
+            std::error_code error;
+            std::filesystem::create_directories(cache().directory, error);
+            std::ofstream file(pathOf(key), std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                std::cout << "ERROR::PROGRAM_CACHE:: cannot write " << pathOf(key).string() << std::endl;
+                return;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), binary.size());
+        }
+    } // namespace
+
+    void ProgramCache::setDirectory(const std::string& directory)
+    {
+        cache().directory = directory;
+    }
+
+    const std::string& ProgramCache::getDirectory()
+    {
+        return cache().directory;
+    }
+
+    uint64_t ProgramCache::makeKey(std::initializer_list<std::string_view> sources)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        hash          = fnv1a(hash, glString(GL_VENDOR));
+        hash          = fnv1a(hash, glString(GL_RENDERER));
+        hash          = fnv1a(hash, glString(GL_VERSION));
+        for (auto source : sources)
+        {
+            hash = fnv1a(hash, source);
+        }
+        return hash;
+    }
+
+    bool ProgramCache::link(GLuint program, uint64_t key, const std::function<bool()>& build)
+    {
+        if (beginLink(program, key))
+        {
+            return true;
+        }
+        auto start  = std::chrono::steady_clock::now();
+        bool linked = build();
+        endLink(program, key, linked, elapsed(start));
+        return linked;
+    }
+
+    bool ProgramCache::beginLink(GLuint program, uint64_t key)
+    {
+        if (!GLExtensions::get().programBinary)
+        {
+            return false;
+        }
+        auto start = std::chrono::steady_clock::now();
+        if (load(program, key))
+        {
+            auto& stats = cache().stats;
+            ++stats.loaded;
+            stats.loadTime += elapsed(start);
+            return true;
+        }
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        return false;
+    }
+
+    void ProgramCache::endLink(GLuint program, uint64_t key, bool linked, double buildTime)
+    {
+        auto& stats = cache().stats;
+        ++stats.built;
+        stats.buildTime += buildTime;
+        if (GLExtensions::get().programBinary && linked)
+        {
+            store(program, key);
+        }
+    }
+
+    const ProgramCache::Stats& ProgramCache::getStats()
+    {
+        return cache().stats;
+    }
+
+    void ProgramCache::printStats()
+    {
+        const auto& stats = cache().stats;
+        std::cout << "ProgramCache: " << stats.built << " built from source in " << stats.buildTime << " ms, "
+                  << stats.loaded << " loaded from binary in " << stats.loadTime << " ms, " << stats.rejected
+                  << " rejected" << std::endl;
+    }
+} // namespace Hub
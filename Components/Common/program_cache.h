@@ -0,0 +1,47 @@
+#pragma once
+#include "utils.h"
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+namespace Hub
+{
+    // On-disk cache of linked programs. A program is keyed by a hash of its sources and the driver vendor,
+    // renderer and version strings, so a driver update or an edited shader simply misses. Binaries are written
+    // with glGetProgramBinary after the first link and loaded with glProgramBinary on the next launch; a binary
+    // the driver rejects is deleted and the program is built from source again.
+    class ProgramCache
+    {
+    public:
+        struct Stats
+        {
+            uint   loaded    = 0; // programs restored from a binary
+            uint   built     = 0; // programs compiled and linked from source
+            uint   rejected  = 0; // binaries the driver refused
+            double loadTime  = 0.0; // ms
+            double buildTime = 0.0;
+        };
+
+        // "./shader_cache" by default, created on the first store
+        static void               setDirectory(const std::string& directory);
+        static const std::string& getDirectory();
+
+        static uint64_t makeKey(std::initializer_list<std::string_view> sources);
+
+        // links program from the cached binary for key, or runs build (compile, attach and link) and caches the
+        // result. build returns the link status, so does link.
+        static bool link(GLuint program, uint64_t key, const std::function<bool()>& build);
+
+        // link split in two for builds that finish later: beginLink is true when the binary was loaded and the
+        // program is linked, otherwise the program is prepared for a build from source that reports back with
+        // endLink once its link status is known
+        static bool beginLink(GLuint program, uint64_t key);
+        static void endLink(GLuint program, uint64_t key, bool linked, double buildTime);
+
+        static const Stats& getStats();
+        // one line with the cold (built) and warm (loaded) timings of this run, printed only when called
+        static void printStats();
+    };
+} // namespace Hub
@@ -0,0 +1,212 @@
+#include "program_pipeline.h"
+#include "gl_extensions.h"
+#include "gl_state.h"
+#include "program_cache.h"
+#include "shader_stage_cache.h"
+
+namespace Hub
+{
+    namespace
+    {
+        GLbitfield stageBit(GLenum type)
+        {
+            switch (type)
+            {
+                case GL_VERTEX_SHADER:
+                    return GL_VERTEX_SHADER_BIT;
+                case GL_FRAGMENT_SHADER:
+                    return GL_FRAGMENT_SHADER_BIT;
+                case GL_GEOMETRY_SHADER:
+                    return GL_GEOMETRY_SHADER_BIT;
+            }
+            return 0;
+        }
+
+        bool checkCompile(GLuint shader, const std::string& path)
+        {
+            GLint  success;
+            GLchar infoLog[512];
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+            if (!success)
+            {
+                glGetShaderInfoLog(shader, 512, nullptr, infoLog);
+                std::cout << "ERROR::SHADER_STAGE::COMPILE:: " << path << ", " << infoLog << std::endl;
+            }
+            return success;
+        }
+
+        bool checkLink(GLuint program, const std::string& path)
+        {
+            GLint  success;
+            GLchar infoLog[512];
+            glGetProgramiv(program, GL_LINK_STATUS, &success);
+            if (!success)
+            {
+                glGetProgramInfoLog(program, 512, nullptr, infoLog);
+                std::cout << "ERROR::SHADER_STAGE::LINK:: " << path << ", " << infoLog << std::endl;
+            }
+            return success;
+        }
+    } // namespace
+
+    SPShaderStage ShaderStage::create(GLenum type, const std::string& path, const ShaderDefines& defines)
+    {
+        return SPShaderStage(new ShaderStage(type, path, defines));
+    }
+
+    ShaderStage::~ShaderStage()
+    {
+        if (_program != 0)
+        {
+            glDeleteProgram(_program);
+            GLState::onDeleteProgram(_program);
+        }
+    }
+
+    GLenum ShaderStage::getType() const
+    {
+        return _type;
+    }
+
+    GLbitfield ShaderStage::getStageBit() const
+    {
+        return stageBit(_type);
+    }
+
+    GLuint ShaderStage::getProgram() const
+    {
+        return _program;
+    }
+
+    bool ShaderStage::isLinked() const
+    {
+        return _linked;
+    }
+
+    UniformHandle ShaderStage::getUniform(std::string_view name) const
+    {
+        return UniformHandle{glGetUniformLocation(_program, std::string(name).c_str())};
+    }
+
+    void ShaderStage::bindUniformBlock(const GLchar* key, unsigned int point)
+    {
+        GLuint index = glGetUniformBlockIndex(_program, key);
+        if (index != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(_program, index, point);
+        }
+    }
+
+    void ShaderStage::setFloat(UniformHandle handle, const GLfloat val)
+    {
+        glProgramUniform1f(_program, handle.location, val);
+    }
+
+    void ShaderStage::setVec2(UniformHandle handle, const glm::vec2& v)
+    {
+        glProgramUniform2fv(_program, handle.location, 1, glm::value_ptr(v));
+    }
+
+    void ShaderStage::setVec3(UniformHandle handle, const glm::vec3& v)
+    {
+        glProgramUniform3fv(_program, handle.location, 1, glm::value_ptr(v));
+    }
+
+    void ShaderStage::setVec4(UniformHandle handle, const glm::vec4& v)
+    {
+        glProgramUniform4fv(_program, handle.location, 1, glm::value_ptr(v));
+    }
+
+    void ShaderStage::setInt(UniformHandle handle, const GLint val)
+    {
+        glProgramUniform1i(_program, handle.location, val);
+    }
+
+    void ShaderStage::setMatirx4(UniformHandle handle, const glm::mat4& mat)
+    {
+        glProgramUniformMatrix4fv(_program, handle.location, 1, GL_FALSE, glm::value_ptr(mat));
+    }
+
+    ShaderStage::ShaderStage(GLenum type, const std::string& path, const ShaderDefines& defines) :
+        _type(type), _path(path)
+    {
+        if (!ProgramPipeline::isSupported())
+        {
+            std::cout << "ERROR::SHADER_STAGE:: separate shader objects are not supported, " << path << std::endl;
+            return;
+        }
+
+        auto source = ShaderPreprocessor::load(path, defines);
+        _program    = glCreateProgram();
+        glProgramParameteri(_program, GL_PROGRAM_SEPARABLE, GL_TRUE);
+
+        // the separable binary differs from a full program linking the same stage, so it gets its own key
+        auto key = ProgramCache::makeKey({"separable", source.code});
+        _linked  = ProgramCache::link(_program, key, [&]() {
+            GLuint shader = ShaderStageCache::get(type, path, defines, source.code);
+            glAttachShader(_program, shader);
+            glLinkProgram(_program);
+            glDetachShader(_program, shader);
+            return checkCompile(shader, path) && checkLink(_program, path);
+        });
+    }
+
+    bool ProgramPipeline::isSupported()
+    {
+        return GLExtensions::get().separateShaderObjects;
+    }
+
+    SPProgramPipeline ProgramPipeline::create(SPShaderStage vertex, SPShaderStage fragment, SPShaderStage geometry)
+    {
+        if (!isSupported())
+        {
+            std::cout << "ERROR::PROGRAM_PIPELINE:: separate shader objects are not supported" << std::endl;
+            return nullptr;
+        }
+        return SPProgramPipeline(new ProgramPipeline(vertex, fragment, geometry));
+    }
+
+    ProgramPipeline::~ProgramPipeline()
+    {
+        glDeleteProgramPipelines(1, &_pipeline);
+        GLState::onDeleteProgramPipeline(_pipeline);
+    }
+
+    void ProgramPipeline::use()
+    {
+        GLState::useProgram(0);
+        GLState::bindProgramPipeline(_pipeline);
+    }
+
+    bool ProgramPipeline::validate()
+    {
+        GLint status = GL_FALSE;
+        glValidateProgramPipeline(_pipeline);
+        glGetProgramPipelineiv(_pipeline, GL_VALIDATE_STATUS, &status);
+        if (!status)
+        {
+            GLchar infoLog[512];
+            glGetProgramPipelineInfoLog(_pipeline, 512, nullptr, infoLog);
+            std::cout << "ERROR::PROGRAM_PIPELINE::VALIDATE\n" << infoLog << std::endl;
+        }
+        return status;
+    }
+
+    GLuint ProgramPipeline::getID() const
+    {
+        return _pipeline;
+    }
+
+    ProgramPipeline::ProgramPipeline(SPShaderStage vertex, SPShaderStage fragment, SPShaderStage geometry) :
+        _stages{vertex, fragment, geometry}
+    {
+        glGenProgramPipelines(1, &_pipeline);
+        for (const auto& stage : _stages)
+        {
+            if (stage && stage->isLinked())
+            {
+                glUseProgramStages(_pipeline, stage->getStageBit(), stage->getProgram());
+            }
+        }
+    }
+} // namespace Hub
@@ -0,0 +1,73 @@
+#pragma once
+#include "utils.h"
+#include "shader.h"
+#include "shader_preprocessor.h"
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace Hub
+{
+    class ShaderStage;
+    using SPShaderStage = std::shared_ptr<ShaderStage>;
+    class ProgramPipeline;
+    using SPProgramPipeline = std::shared_ptr<ProgramPipeline>;
+
+    // One stage linked on its own into a separable program (GL 4.1 / ARB_separate_shader_objects). Stages are
+    // combined by ProgramPipeline, so N vertex and M fragment stages need N + M links instead of N * M.
+    // Uniforms are written with glProgramUniform*, the stage does not have to be in use.
+    class ShaderStage
+    {
+    public:
+        // type is GL_VERTEX_SHADER, GL_FRAGMENT_SHADER or GL_GEOMETRY_SHADER
+        static SPShaderStage create(GLenum type, const std::string& path, const ShaderDefines& defines = {});
+        ~ShaderStage();
+
+        GLenum     getType() const;
+        GLbitfield getStageBit() const;
+        GLuint     getProgram() const;
+        bool       isLinked() const;
+
+        UniformHandle getUniform(std::string_view name) const;
+        void          bindUniformBlock(const GLchar* key, unsigned int point);
+
+        void setFloat(UniformHandle handle, const GLfloat val);
+        void setVec2(UniformHandle handle, const glm::vec2& v);
+        void setVec3(UniformHandle handle, const glm::vec3& v);
+        void setVec4(UniformHandle handle, const glm::vec4& v);
+        void setInt(UniformHandle handle, const GLint val);
+        void setMatirx4(UniformHandle handle, const glm::mat4& mat);
+
+    private:
+        ShaderStage(GLenum type, const std::string& path, const ShaderDefines& defines);
+
+        GLenum      _type;
+        std::string _path;
+        GLuint      _program = 0;
+        bool        _linked  = false;
+    };
+
+    // Program pipeline object made of separable stages. Every pipeline sharing a stage shares its program, so
+    // switching between them only swaps the stages that differ. Needs GLExtensions::separateShaderObjects,
+    // check isSupported() and fall back to Shader, which still shares compiled stages through ShaderStageCache.
+    class ProgramPipeline
+    {
+    public:
+        static bool              isSupported();
+        static SPProgramPipeline create(SPShaderStage vertex, SPShaderStage fragment, SPShaderStage geometry = nullptr);
+        ~ProgramPipeline();
+
+        // unbinds the current program, a program in use takes precedence over the pipeline
+        void use();
+        // validates against the current state, logs the pipeline info log on failure
+        bool validate();
+
+        GLuint getID() const;
+
+    private:
+        ProgramPipeline(SPShaderStage vertex, SPShaderStage fragment, SPShaderStage geometry);
+
+        GLuint        _pipeline = 0;
+        SPShaderStage _stages[3]; // vertex, fragment, geometry (may be null), kept alive while in the pipeline
+    };
+} // namespace Hub
@@ -1,4 +1,6 @@
 #include "render_buffer.h"
+#include "gl_extensions.h"
+#include "gl_deletion_queue.h"
 
 namespace Hub
 {
@@ -9,7 +11,7 @@ namespace Hub
 
     RenderBuffer::~RenderBuffer()
     {
-        glDeleteBuffers(1, &_obj);
+        GLDeletionQueue::release(GLObject::RenderBuffer, _obj);
     }
 
     RenderBuffer::operator GLuint() const
@@ -17,9 +19,27 @@ namespace Hub
         return _obj;
     }
 
-    RenderBuffer::RenderBuffer()
+    void RenderBuffer::storage(GLenum internalFormat, int width, int height, int samples)
     {
-        glGenRenderbuffers(1, &_obj);
+        if (_dsa)
+        {
+            glNamedRenderbufferStorageMultisample(_obj, samples, internalFormat, width, height);
+            return;
+        }
+        glBindRenderbuffer(GL_RENDERBUFFER, _obj);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, internalFormat, width, height);
     }
 
-} // namespace Hub
\ No newline at end of file
+    RenderBuffer::RenderBuffer() : _dsa(GLExtensions::get().directStateAccess)
+    {
+        if (_dsa)
+        {
+            glCreateRenderbuffers(1, &_obj);
+        }
+        else
+        {
+            glGenRenderbuffers(1, &_obj);
+        }
+    }
+
+} // namespace Hub
@@ -1,5 +1,6 @@
 #pragma once
 #include "utils.h"
+#include <memory>
 
 namespace Hub
 {
@@ -13,8 +14,14 @@ namespace Hub
         ~RenderBuffer();
         operator GLuint() const;
 
+        // samples = 0 allocates single sampled storage
+        void storage(GLenum internalFormat, int width, int height, int samples = 0);
+
     private:
+        template <typename>
+        friend class HandlePool;
         RenderBuffer();
         GLuint _obj;
+        bool   _dsa;
     };
-} // namespace Hub
\ No newline at end of file
+} // namespace Hub
@@ -0,0 +1,180 @@
+#include "render_target_pool.h"
+
+namespace Hub
+{
+    namespace
+    {
+        template <typename T>
+        void destroyPooled(HandlePool<T>& pool, Handle<T> handle)
+        {
+            // GLResources::clear() already destroyed everything when the pool outlives the window
+            if (pool.isValid(handle))
+            {
+                pool.destroy(handle);
+            }
+        }
+    } // namespace
+
+    SPRenderTargetPool RenderTargetPool::create(uint evictAfterFrames)
+    {
+        return SPRenderTargetPool(new RenderTargetPool(evictAfterFrames));
+    }
+
+    RenderTargetPool::~RenderTargetPool()
+    {
+        for (auto& entry : _entries)
+        {
+            destroy(*entry.target);
+        }
+    }
+
+    SPRenderTarget RenderTargetPool::acquire(const RenderTargetDesc& desc)
+    {
+        RenderTargetDesc resolved = resolve(desc);
+        for (auto& entry : _entries)
+        {
+            if (!entry.inUse && entry.target->desc == resolved)
+            {
+                entry.inUse    = true;
+                entry.lastUsed = _frame;
+                return entry.target;
+            }
+        }
+
+        Entry entry;
+        entry.target   = build(resolved);
+        entry.inUse    = true;
+        entry.lastUsed = _frame;
+        _entries.push_back(entry);
+        return entry.target;
+    }
+
+    void RenderTargetPool::release(const SPRenderTarget& target)
+    {
+        for (auto& entry : _entries)
+        {
+            if (entry.target == target)
+            {
+                entry.inUse    = false;
+                entry.lastUsed = _frame;
+                return;
+            }
+        }
+    }
+
+    void RenderTargetPool::setViewportSize(int width, int height)
+    {
+        _viewportWidth  = width;
+        _viewportHeight = height;
+    }
+
+    void RenderTargetPool::newFrame()
+    {
+        ++_frame;
+        std::erase_if(_entries, [this](const Entry& entry) {
+            if (entry.inUse || _frame - entry.lastUsed <= _evictAfterFrames)
+            {
+                return false;
+            }
+            destroy(*entry.target);
+            return true;
+        });
+    }
+
+    uint RenderTargetPool::getTargetCount() const
+    {
+        return static_cast<uint>(_entries.size());
+    }
+
+    RenderTargetPool::RenderTargetPool(uint evictAfterFrames) : _evictAfterFrames(evictAfterFrames) {}
+
+    RenderTargetDesc RenderTargetPool::resolve(const RenderTargetDesc& desc) const
+    {
+        RenderTargetDesc resolved = desc;
+        if (resolved.width == 0)
+        {
+            resolved.width = _viewportWidth;
+        }
+        if (resolved.height == 0)
+        {
+            resolved.height = _viewportHeight;
+        }
+        return resolved;
+    }
+
+    SPRenderTarget RenderTargetPool::build(const RenderTargetDesc& desc) const
+    {
+        auto& frameBuffers = GLResources::frameBuffers();
+        auto& textures     = GLResources::textures();
+
+        auto target               = std::make_shared<RenderTarget>();
+        target->desc              = desc;
+        target->frameBufferHandle = frameBuffers.create();
+        target->frameBuffer       = frameBuffers.get(target->frameBufferHandle);
+        auto& frameBuffer         = *target->frameBuffer;
+
+        if (desc.color)
+        {
+            if (desc.samples > 0)
+            {
+                target->colorTextureHandle = textures.create(Texture2DMultisample);
+                target->colorTexture       = textures.get(target->colorTextureHandle);
+                target->colorTexture->image2DMultisample(desc.width, desc.height, desc.samples, desc.format);
+            }
+            else
+            {
+                target->colorTextureHandle = textures.create(Texture2D);
+                target->colorTexture       = textures.get(target->colorTextureHandle);
+                target->colorTexture->image2D(nullptr, desc.format, desc.width, desc.height, Type::UnsignedByte);
+                target->colorTexture->setFilter(Filter::Min, Filter::Linear);
+                target->colorTexture->setFilter(Filter::Mag, Filter::Linear);
+                target->colorTexture->setWrapping(Wrapping::S, Wrapping::ClampEdge);
+                target->colorTexture->setWrapping(Wrapping::T, Wrapping::ClampEdge);
+            }
+            frameBuffer.attachTexture(GL_COLOR_ATTACHMENT0, *target->colorTexture);
+        }
+        else
+        {
+            frameBuffer.setDrawBuffer(GL_NONE);
+            frameBuffer.setReadBuffer(GL_NONE);
+        }
+
+        // multisampled depth textures are not supported, those fall back to a render buffer
+        bool depthTexture = desc.depth == DepthAttachment::Texture && desc.samples == 0;
+        if (depthTexture)
+        {
+            target->depthTextureHandle = textures.create(Texture2D);
+            target->depthTexture       = textures.get(target->depthTextureHandle);
+            target->depthTexture->image2D(nullptr, Format::DEPTH, desc.width, desc.height, Type::Float);
+            target->depthTexture->setFilter(Filter::Min, Filter::Nearest);
+            target->depthTexture->setFilter(Filter::Mag, Filter::Nearest);
+            target->depthTexture->setWrapping(Wrapping::S, Wrapping::ClampBorder);
+            target->depthTexture->setWrapping(Wrapping::T, Wrapping::ClampBorder);
+            target->depthTexture->setBorderColor(Color(1.0f));
+            frameBuffer.attachTexture(GL_DEPTH_ATTACHMENT, *target->depthTexture);
+        }
+        else if (desc.depth != DepthAttachment::None)
+        {
+            target->depthStencilHandle = GLResources::renderBuffers().create();
+            target->depthStencil       = GLResources::renderBuffers().get(target->depthStencilHandle);
+            target->depthStencil->storage(GL_DEPTH24_STENCIL8, desc.width, desc.height, desc.samples);
+            frameBuffer.attachRenderBuffer(GL_DEPTH_STENCIL_ATTACHMENT, *target->depthStencil);
+        }
+
+        if (!frameBuffer.isComplete())
+        {
+            std::cout << "ERROR::RENDER_TARGET_POOL:: framebuffer " << desc.width << "x" << desc.height
+                      << " is not complete!" << std::endl;
+        }
+        return target;
+    }
+
+    void RenderTargetPool::destroy(RenderTarget& target)
+    {
+        destroyPooled(GLResources::frameBuffers(), target.frameBufferHandle);
+        destroyPooled(GLResources::textures(), target.colorTextureHandle);
+        destroyPooled(GLResources::textures(), target.depthTextureHandle);
+        destroyPooled(GLResources::renderBuffers(), target.depthStencilHandle);
+        target = RenderTarget{target.desc};
+    }
+} // namespace Hub
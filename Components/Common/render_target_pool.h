@@ -0,0 +1,91 @@
+#pragma once
+#include "utils.h"
+#include "gl_resources.h"
+#include <memory>
+#include <vector>
+
+namespace Hub
+{
+    namespace DepthAttachment
+    {
+        enum depth_t
+        {
+            None,
+            RenderBuffer, // depth24 stencil8, not sampleable
+            Texture,      // depth texture, e.g. shadow maps
+        };
+    }
+
+    struct RenderTargetDesc
+    {
+        int                      width   = 0; // 0 follows the viewport size set on the pool
+        int                      height  = 0;
+        bool                     color   = true;
+        Format::format_t         format  = Format::RGB;
+        int                      samples = 0; // > 0 gives multisampled attachments
+        DepthAttachment::depth_t depth   = DepthAttachment::None;
+
+        bool operator==(const RenderTargetDesc& other) const = default;
+    };
+
+    // A complete FBO with the attachments its descriptor asks for. The GL objects live in the GLResources pools
+    // and belong to the RenderTargetPool, the pointers stay valid until the target is evicted.
+    struct RenderTarget
+    {
+        RenderTargetDesc desc; // resolved, width and height are never 0
+        FrameBuffer*     frameBuffer  = nullptr;
+        Texture*         colorTexture = nullptr;
+        Texture*         depthTexture = nullptr;
+        RenderBuffer*    depthStencil = nullptr;
+
+        FrameBufferHandle  frameBufferHandle  = {};
+        TextureHandle      colorTextureHandle = {};
+        TextureHandle      depthTextureHandle = {};
+        RenderBufferHandle depthStencilHandle = {};
+    };
+    using SPRenderTarget = std::shared_ptr<RenderTarget>;
+
+    class RenderTargetPool;
+    using SPRenderTargetPool = std::shared_ptr<RenderTargetPool>;
+
+    // Transient render targets shared between passes. A pass acquires a target matching its descriptor and
+    // releases it when done, so the next pass asking for the same descriptor reuses the same FBO.
+    // Targets that stay unused for evictAfterFrames frames are destroyed, which also drops the targets of the
+    // old size after the viewport changed.
+    class RenderTargetPool
+    {
+    public:
+        static SPRenderTargetPool create(uint evictAfterFrames = 3);
+        ~RenderTargetPool();
+
+        SPRenderTarget acquire(const RenderTargetDesc& desc);
+        void           release(const SPRenderTarget& target);
+
+        // sizes of descriptors with width or height 0, targets are reallocated lazily on the next acquire
+        void setViewportSize(int width, int height);
+        // evicts targets unused for too long, call once per frame
+        void newFrame();
+
+        uint getTargetCount() const;
+
+    private:
+        struct Entry
+        {
+            SPRenderTarget target;
+            bool           inUse    = false;
+            uint           lastUsed = 0;
+        };
+
+        RenderTargetPool(uint evictAfterFrames);
+
+        RenderTargetDesc resolve(const RenderTargetDesc& desc) const;
+        SPRenderTarget   build(const RenderTargetDesc& desc) const;
+        static void      destroy(RenderTarget& target);
+
+        std::vector<Entry> _entries;
+        uint               _evictAfterFrames;
+        uint               _frame          = 0;
+        int                _viewportWidth  = 0;
+        int                _viewportHeight = 0;
+    };
+} // namespace Hub
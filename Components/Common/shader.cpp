@@ -1,100 +1,418 @@
 ﻿#include "shader.h"
+#include "gl_state.h"
+#include "program_cache.h"
+#include "shader_stage_cache.h"
+#include "gl_extensions.h"
+#include <algorithm>
+#include <cstring>
 
 namespace Hub
 {
-    Shader::Shader(const GLchar* vsPath, const GLchar* fsPath, const char* gsPath)
-    {
-        std::string   vertexCode;
-        std::string   fragmentCode;
-        std::string   geometryCode;
-        std::ifstream vShaderFile;
-        std::ifstream fShaderFile;
-        std::ifstream gShaderFile;
-        // 保证ifstream对象可以抛出异常；
-        vShaderFile.exceptions(std::ifstream::badbit);
-        fShaderFile.exceptions(std::ifstream::badbit);
-        gShaderFile.exceptions(std::ifstream::badbit);
-        try
-        {
-            // 打开文件
-            vShaderFile.open(vsPath);
-            fShaderFile.open(fsPath);
-            // 读取文件到缓冲内容到流中
-            std::stringstream vShaderStream, fShaderStream;
-            vShaderStream << vShaderFile.rdbuf();
-            fShaderStream << fShaderFile.rdbuf();
-            // 关闭文件
-            vShaderFile.close();
-            fShaderFile.close();
-            // 转换至GLchar数组
-            vertexCode   = vShaderStream.str();
-            fragmentCode = fShaderStream.str();
-
-            // 几何着色器代码加载
-            if (gsPath != nullptr)
+    namespace
+    {
+        GLuint s_placeholderProgram = 0;
+        // generations are unique across shaders, a Shader built where a destroyed one lived never repeats its
+        // (address, generation) pair
+        unsigned int s_lastGeneration = 0;
+
+        Shader::UniformStats s_uniformStats;
+        Shader::UniformStats s_frameUniformStats;
+
+        // drawn instead of a program that is still building: valid to draw with, produces no fragments
+        GLuint placeholderProgram()
+        {
+            if (s_placeholderProgram != 0)
             {
-                gShaderFile.open(gsPath);
-                std::stringstream gShaderStream;
-                gShaderStream << gShaderFile.rdbuf();
-                gShaderFile.close();
-                geometryCode = gShaderStream.str();
+                return s_placeholderProgram;
             }
+            const GLchar* vsCode = "#version 330 core\nvoid main() { gl_Position = vec4(0.0); }\n";
+            const GLchar* fsCode = "#version 330 core\nout vec4 FragColor;\nvoid main() { FragColor = vec4(1.0); }\n";
+            GLuint        vs     = glCreateShader(GL_VERTEX_SHADER);
+            GLuint        fs     = glCreateShader(GL_FRAGMENT_SHADER);
+            glShaderSource(vs, 1, &vsCode, nullptr);
+            glShaderSource(fs, 1, &fsCode, nullptr);
+            glCompileShader(vs);
+            glCompileShader(fs);
+            s_placeholderProgram = glCreateProgram();
+            glAttachShader(s_placeholderProgram, vs);
+            glAttachShader(s_placeholderProgram, fs);
+            glLinkProgram(s_placeholderProgram);
+            glDetachShader(s_placeholderProgram, vs);
+            glDetachShader(s_placeholderProgram, fs);
+            glDeleteShader(vs);
+            glDeleteShader(fs);
+            return s_placeholderProgram;
+        }
+    } // namespace
+
+    Shader::Shader(const GLchar*        vsPath,
+                   const GLchar*        fsPath,
+                   const char*          gsPath,
+                   const ShaderDefines& defines,
+                   ShaderBuild::build_t build) :
+        _defines(defines), _generation(++s_lastGeneration)
+    {
+        _paths[0] = vsPath;
+        _paths[1] = fsPath;
+        _paths[2] = gsPath != nullptr ? gsPath : "";
+
+        // 创建一个着色器程序: 用于链接shader
+        _programID = glCreateProgram();
+        _pending   = submit(_programID);
+        if (!_pending)
+        {
+            reflect();
+        }
+        else if (build == ShaderBuild::Blocking)
+        {
+            finishBuild();
         }
-        catch (std::ifstream::failure e)
+    }
+
+    void Shader::use()
+    {
+        if (!ready())
         {
-            std::cout << "ERROR::SHADER::FILE_NOT_SUCCEDDFULLY_READ" << std::endl;
+            GLState::useProgram(placeholderProgram());
+            return;
         }
-        const GLchar* vShaderCode = vertexCode.c_str();
-        const GLchar* fShaderCode = fragmentCode.c_str();
+        GLState::useProgram(_programID);
+        flush();
+    }
 
-        GLuint vertexShader;
-        vertexShader = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(
-            vertexShader, 1, &vShaderCode, nullptr); // 着色源码附加到着色对象， 第二个参数指传递的源码字符串数量
-        glCompileShader(vertexShader);
-        checkShaderCompile(vertexShader, vsPath);
+    bool Shader::ready()
+    {
+        if (!_pending)
+        {
+            return true;
+        }
+        if (!isComplete(*_pending))
+        {
+            return false;
+        }
+        finishBuild();
+        return true;
+    }
 
-        GLuint fragmentShader;
-        fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragmentShader, 1, &fShaderCode, nullptr);
-        glCompileShader(fragmentShader);
-        checkShaderCompile(fragmentShader, fsPath);
+    bool Shader::isBuilding() const
+    {
+        return _pending != nullptr;
+    }
 
-        GLuint geometryShader;
-        if (gsPath != nullptr)
+    bool Shader::reload()
+    {
+        if (_reload || !ready())
+        {
+            return false;
+        }
+        GLuint program = glCreateProgram();
+        _reload        = submit(program);
+        if (!_reload)
         {
-            const GLchar* gShaderCode = geometryCode.c_str();
-            geometryShader            = glCreateShader(GL_GEOMETRY_SHADER);
-            glShaderSource(geometryShader, 1, &gShaderCode, nullptr);
-            glCompileShader(geometryShader);
-            checkShaderCompile(geometryShader, gsPath);
+            swapProgram(program); // unchanged sources, the binary came from the cache
         }
+        return true;
+    }
 
-        // 创建一个着色器程序: 用于链接shader
-        _programID = glCreateProgram();
+    bool Shader::pollReload()
+    {
+        if (!_reload || !isComplete(*_reload))
+        {
+            return false;
+        }
+        auto build = _reload;
+        _reload    = nullptr;
+        if (finish(*build))
+        {
+            swapProgram(build->program);
+        }
+        else
+        {
+            glDeleteProgram(build->program);
+            std::cout << "ERROR::SHADER::RELOAD:: " << _paths[1] << " failed, keeping the previous program" << std::endl;
+        }
+        return true;
+    }
+
+    bool Shader::isReloading() const
+    {
+        return _reload != nullptr;
+    }
+
+    unsigned int Shader::getGeneration() const
+    {
+        return _generation;
+    }
+
+    const std::vector<std::string>& Shader::getSourceFiles() const
+    {
+        return _sourceFiles;
+    }
 
-        // 将着色器对象附加到着色程序上
-        glAttachShader(_programID, vertexShader);
-        glAttachShader(_programID, fragmentShader);
-        if (gsPath != nullptr)
+    void Shader::releasePlaceholder()
+    {
+        if (s_placeholderProgram != 0)
         {
-            glAttachShader(_programID, geometryShader);
+            glDeleteProgram(s_placeholderProgram);
+            GLState::onDeleteProgram(s_placeholderProgram);
+            s_placeholderProgram = 0;
         }
-        glLinkProgram(_programID);
-        checkProgramLink();
+    }
 
-        // 链接完成删除着色对象
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
-        if (gsPath != nullptr)
+    void Shader::setUniformUpdate(UniformUpdate::update_t update)
+    {
+        _uniformUpdate = update;
+    }
+
+    void Shader::flush()
+    {
+        // glUniform* goes to the program in use, uploading while another one is bound would record values this
+        // program never received
+        if (_dirty.empty() || !GLState::isProgramInUse(_programID))
         {
-            glDeleteShader(geometryShader);
+            return;
         }
+        for (unsigned int index : _dirty)
+        {
+            auto& value = _values[index];
+            upload(value.location, value.kind, value.data);
+            value.dirty = false;
+        }
+        _dirty.clear();
     }
 
-    void Shader::use()
+    void Shader::newFrame()
+    {
+        s_frameUniformStats = s_uniformStats;
+        s_uniformStats      = UniformStats();
+    }
+
+    const Shader::UniformStats& Shader::getFrameUniformStats()
+    {
+        return s_frameUniformStats;
+    }
+
+    std::shared_ptr<Shader::PendingBuild> Shader::submit(GLuint program)
+    {
+        // 读取源码, 展开 #include 并在 #version 之后插入宏定义
+        const GLenum types[3] = {GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER};
+        std::string  code[3];
+        _sourceFiles.clear();
+        for (int stage = 0; stage < 3; ++stage)
+        {
+            if (_paths[stage].empty())
+            {
+                continue;
+            }
+            auto source = ShaderPreprocessor::load(_paths[stage], _defines);
+            code[stage] = source.code;
+            for (const auto& file : source.files)
+            {
+                if (std::find(_sourceFiles.begin(), _sourceFiles.end(), file) == _sourceFiles.end())
+                {
+                    _sourceFiles.push_back(file);
+                }
+            }
+        }
+
+        // 源码没有变化时直接从缓存的二进制加载, 跳过编译和链接
+        auto key = ProgramCache::makeKey({code[0], code[1], code[2]});
+        if (ProgramCache::beginLink(program, key))
+        {
+            return nullptr;
+        }
+
+        // 提交全部编译和链接, 不查询状态, 驱动可以在后台线程并行编译
+        auto build     = std::make_shared<PendingBuild>();
+        build->program = program;
+        build->key     = key;
+        build->start   = std::chrono::steady_clock::now();
+        for (int stage = 0; stage < 3; ++stage)
+        {
+            if (_paths[stage].empty())
+            {
+                continue;
+            }
+            // 相同路径和宏定义的着色对象只编译一次, 由多个程序共享
+            GLuint shader = ShaderStageCache::get(types[stage], _paths[stage], _defines, code[stage]);
+            // 将着色器对象附加到着色程序上
+            glAttachShader(program, shader);
+            build->stages[stage] = shader;
+        }
+        glLinkProgram(program);
+        return build;
+    }
+
+    bool Shader::isComplete(const PendingBuild& build) const
+    {
+        // without the parallel compile extension the status query in finish blocks until the link is done
+        if (!GLExtensions::get().parallelShaderCompile)
+        {
+            return true;
+        }
+        GLint completed = GL_FALSE;
+        glGetProgramiv(build.program, GL_COMPLETION_STATUS_KHR, &completed);
+        return completed == GL_TRUE;
+    }
+
+    bool Shader::finish(PendingBuild& build)
+    {
+        for (int stage = 0; stage < 3; ++stage)
+        {
+            if (build.stages[stage] != 0)
+            {
+                checkShaderCompile(build.stages[stage], _paths[stage].c_str());
+            }
+        }
+        bool linked = checkProgramLink(build.program);
+
+        // 链接完成分离着色对象, 对象归 ShaderStageCache 所有, 不在这里删除
+        for (GLuint shader : build.stages)
+        {
+            if (shader != 0)
+            {
+                glDetachShader(build.program, shader);
+            }
+        }
+        double buildTime =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build.start).count();
+        ProgramCache::endLink(build.program, build.key, linked, buildTime);
+        return linked;
+    }
+
+    void Shader::finishBuild()
+    {
+        finish(*_pending);
+        _pending = nullptr;
+        reflect();
+    }
+
+    void Shader::swapProgram(GLuint program)
     {
-        glUseProgram(_programID);
+        GLuint oldProgram         = _programID;
+        auto   oldUniforms        = std::move(_uniforms);
+        auto   oldBlocks          = std::move(_uniformBlocks);
+        auto   oldValues          = std::move(_values);
+        auto   oldValueOfLocation = std::move(_valueOfLocation);
+        _programID                = program;
+        reflect();
+
+        // carry over what was set once at startup: uniform values (samplers units, constants) and block bindings
+        GLState::useProgram(_programID);
+        for (const auto& [name, uniform] : oldUniforms)
+        {
+            auto target = findUniform(name);
+            if (target && target->type == uniform.type && uniform.location >= 0)
+            {
+                copyUniform(oldProgram, uniform.location, target->location, uniform.type);
+                keepDirtyValue(oldValues, oldValueOfLocation, uniform.location, target->location);
+            }
+        }
+        for (const auto& [name, block] : oldBlocks)
+        {
+            auto target = findUniformBlock(name);
+            if (target)
+            {
+                GLint binding = 0;
+                glGetActiveUniformBlockiv(oldProgram, block.index, GL_UNIFORM_BLOCK_BINDING, &binding);
+                glUniformBlockBinding(_programID, target->index, binding);
+            }
+        }
+
+        glDeleteProgram(oldProgram);
+        GLState::onDeleteProgram(oldProgram);
+        _generation = ++s_lastGeneration;
+    }
+
+    void Shader::keepDirtyValue(const std::vector<UniformValue>& oldValues,
+                                const std::vector<int>&          oldValueOfLocation,
+                                GLint                            from,
+                                GLint                            to)
+    {
+        // a Deferred value written since the last flush never reached the old program, copyUniform missed it
+        auto source = static_cast<size_t>(from);
+        auto target = static_cast<size_t>(to);
+        if (to < 0 || source >= oldValueOfLocation.size() || oldValueOfLocation[source] < 0 ||
+            target >= _valueOfLocation.size() || _valueOfLocation[target] < 0)
+        {
+            return;
+        }
+        const auto& value = oldValues[oldValueOfLocation[source]];
+        if (!value.dirty)
+        {
+            return;
+        }
+        auto  index = static_cast<unsigned int>(_valueOfLocation[target]);
+        auto& copy  = _values[index];
+        copy.kind   = value.kind;
+        std::memcpy(copy.data, value.data, sizeof(copy.data));
+        if (!copy.dirty)
+        {
+            copy.dirty = true;
+            _dirty.push_back(index);
+        }
+    }
+
+    void Shader::copyUniform(GLuint source, GLint from, GLint to, GLenum type)
+    {
+        GLfloat f[16];
+        GLint   i[4];
+        GLuint  u[4];
+        switch (type)
+        {
+            case GL_FLOAT:
+                glGetUniformfv(source, from, f);
+                glUniform1fv(to, 1, f);
+                break;
+            case GL_FLOAT_VEC2:
+                glGetUniformfv(source, from, f);
+                glUniform2fv(to, 1, f);
+                break;
+            case GL_FLOAT_VEC3:
+                glGetUniformfv(source, from, f);
+                glUniform3fv(to, 1, f);
+                break;
+            case GL_FLOAT_VEC4:
+                glGetUniformfv(source, from, f);
+                glUniform4fv(to, 1, f);
+                break;
+            case GL_FLOAT_MAT2:
+                glGetUniformfv(source, from, f);
+                glUniformMatrix2fv(to, 1, GL_FALSE, f);
+                break;
+            case GL_FLOAT_MAT3:
+                glGetUniformfv(source, from, f);
+                glUniformMatrix3fv(to, 1, GL_FALSE, f);
+                break;
+            case GL_FLOAT_MAT4:
+                glGetUniformfv(source, from, f);
+                glUniformMatrix4fv(to, 1, GL_FALSE, f);
+                break;
+            case GL_INT_VEC2:
+            case GL_BOOL_VEC2:
+                glGetUniformiv(source, from, i);
+                glUniform2iv(to, 1, i);
+                break;
+            case GL_INT_VEC3:
+            case GL_BOOL_VEC3:
+                glGetUniformiv(source, from, i);
+                glUniform3iv(to, 1, i);
+                break;
+            case GL_INT_VEC4:
+            case GL_BOOL_VEC4:
+                glGetUniformiv(source, from, i);
+                glUniform4iv(to, 1, i);
+                break;
+            case GL_UNSIGNED_INT:
+                glGetUniformuiv(source, from, u);
+                glUniform1uiv(to, 1, u);
+                break;
+            default:
+                // int, bool and every sampler type
+                glGetUniformiv(source, from, i);
+                glUniform1iv(to, 1, i);
+                break;
+        }
     }
 
     void Shader::checkShaderCompile(const GLuint shader, const GLchar* filePath)
@@ -109,66 +427,254 @@ namespace Hub
         }
     }
 
-    void Shader::checkProgramLink()
+    bool Shader::checkProgramLink()
+    {
+        return checkProgramLink(_programID);
+    }
+
+    bool Shader::checkProgramLink(GLuint program)
     {
         GLint  success;
         GLchar infoLog[512];
-        glGetProgramiv(_programID, GL_LINK_STATUS, &success);
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
         if (!success)
         {
-            glGetProgramInfoLog(_programID, 512, nullptr, infoLog);
+            glGetProgramInfoLog(program, 512, nullptr, infoLog);
             std::cout << "ERROR::PROGRAM::LINK::FAILED\n" << infoLog << std::endl;
         }
+        return success;
     }
 
     void Shader::setFloat(const GLchar* key, const GLfloat val)
     {
-        GLint keyLocation = glGetUniformLocation(_programID, key);
-        // std::cout <<key<<" getlocal res = "<< keyLocation << std::endl;
-        glUniform1f(keyLocation, val);
+        setFloat(getUniform(key), val);
     }
 
     void Shader::setVec4(const GLchar* key, const glm::vec4& v)
     {
-        GLint keyLocation = glGetUniformLocation(_programID, key);
-        glUniform4f(keyLocation, v.x, v.y, v.z, v.w);
+        setVec4(getUniform(key), v);
     }
 
     void Shader::setVec3(const GLchar* key, const glm::vec3& v)
     {
-        GLint keyLocation = glGetUniformLocation(_programID, key);
-        glUniform3f(keyLocation, v.x, v.y, v.z);
+        setVec3(getUniform(key), v);
     }
 
     void Shader::setVec3(const GLchar* key, float x, float y, float z)
     {
-        GLint keyLocation = glGetUniformLocation(_programID, key);
-        glUniform3f(keyLocation, x, y, z);
+        setVec3(getUniform(key), x, y, z);
     }
 
     void Shader::setVec2(const GLchar* key, const glm::vec2& v)
     {
-        GLint keyLocation = glGetUniformLocation(_programID, key);
-        glUniform2f(keyLocation, v.x, v.y);
+        setVec2(getUniform(key), v);
     }
 
     void Shader::setInt(const GLchar* key, const GLint val)
     {
-        GLint keyLocation = glGetUniformLocation(_programID, key);
-        glUniform1i(keyLocation, val);
+        setInt(getUniform(key), val);
     }
 
     void Shader::setMatirx4(const GLchar* key, const glm::mat4& mat)
     {
-        GLint keyLocation = glGetUniformLocation(_programID, key);
-        glUniformMatrix4fv(
-            keyLocation, 1, GL_FALSE, glm::value_ptr(mat)); // 第二个参数：矩阵个数，第三个： 行列是否置换
+        setMatirx4(getUniform(key), mat);
     }
 
     void Shader::bindUniformBlock(const GLchar* key, unsigned int point)
     {
-        unsigned int index = glGetUniformBlockIndex(_programID, key);
-        glUniformBlockBinding(_programID, index, point);
+        if (auto block = findUniformBlock(key))
+        {
+            glUniformBlockBinding(_programID, block->index, point);
+        }
+    }
+
+    UniformHandle Shader::getUniform(std::string_view name) const
+    {
+        auto uniform = findUniform(name);
+        return uniform ? UniformHandle{uniform->location} : UniformHandle();
+    }
+
+    const Shader::UniformInfo* Shader::findUniform(std::string_view name) const
+    {
+        auto it = _uniforms.find(name);
+        return it != _uniforms.end() ? &it->second : nullptr;
+    }
+
+    const Shader::UniformBlockInfo* Shader::findUniformBlock(std::string_view name) const
+    {
+        auto it = _uniformBlocks.find(name);
+        return it != _uniformBlocks.end() ? &it->second : nullptr;
+    }
+
+    void Shader::setFloat(UniformHandle handle, const GLfloat val)
+    {
+        write(handle, Float1, &val, sizeof(val));
+    }
+
+    void Shader::setVec4(UniformHandle handle, const glm::vec4& v)
+    {
+        write(handle, Float4, glm::value_ptr(v), sizeof(v));
+    }
+
+    void Shader::setVec3(UniformHandle handle, const glm::vec3& v)
+    {
+        write(handle, Float3, glm::value_ptr(v), sizeof(v));
+    }
+
+    void Shader::setVec3(UniformHandle handle, float x, float y, float z)
+    {
+        setVec3(handle, glm::vec3(x, y, z));
+    }
+
+    void Shader::setVec2(UniformHandle handle, const glm::vec2& v)
+    {
+        write(handle, Float2, glm::value_ptr(v), sizeof(v));
+    }
+
+    void Shader::setInt(UniformHandle handle, const GLint val)
+    {
+        write(handle, Int1, &val, sizeof(val));
+    }
+
+    void Shader::setMatirx4(UniformHandle handle, const glm::mat4& mat)
+    {
+        write(handle, Matrix4, glm::value_ptr(mat), sizeof(mat));
+    }
+
+    void Shader::write(UniformHandle handle, ValueKind kind, const void* data, size_t size)
+    {
+        if (!handle.isValid())
+        {
+            return;
+        }
+        auto location = static_cast<size_t>(handle.location);
+        if (location >= _valueOfLocation.size() || _valueOfLocation[location] < 0)
+        {
+            // not a location of this program, upload as is
+            GLfloat copy[16];
+            std::memcpy(copy, data, size);
+            upload(handle.location, kind, copy);
+            return;
+        }
+
+        auto  index = static_cast<unsigned int>(_valueOfLocation[location]);
+        auto& value = _values[index];
+        if (value.kind == kind && std::memcmp(value.data, data, size) == 0)
+        {
+            ++s_uniformStats.elided;
+            return;
+        }
+        value.kind = kind;
+        std::memcpy(value.data, data, size);
+        if (!value.dirty)
+        {
+            value.dirty = true;
+            _dirty.push_back(index);
+        }
+        if (_uniformUpdate == UniformUpdate::Immediate)
+        {
+            flush();
+        }
+    }
+
+    void Shader::upload(GLint location, int kind, const GLfloat* data)
+    {
+        ++s_uniformStats.issued;
+        switch (kind)
+        {
+            case Float1:
+                glUniform1fv(location, 1, data);
+                break;
+            case Float2:
+                glUniform2fv(location, 1, data);
+                break;
+            case Float3:
+                glUniform3fv(location, 1, data);
+                break;
+            case Float4:
+                glUniform4fv(location, 1, data);
+                break;
+            case Int1:
+                glUniform1iv(location, 1, reinterpret_cast<const GLint*>(data));
+                break;
+            case Matrix4:
+                // 第二个参数：矩阵个数，第三个： 行列是否置换
+                glUniformMatrix4fv(location, 1, GL_FALSE, data);
+                break;
+        }
+    }
+
+    void Shader::reflect()
+    {
+        _uniforms.clear();
+        _uniformBlocks.clear();
+
+        GLint  count = 0;
+        GLchar name[256];
+        glGetProgramiv(_programID, GL_ACTIVE_UNIFORMS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLuint  index      = static_cast<GLuint>(i);
+            GLint   blockIndex = -1;
+            GLint   size       = 0;
+            GLenum  type       = GL_NONE;
+            GLsizei length     = 0;
+            glGetActiveUniformsiv(_programID, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+            if (blockIndex != -1)
+            {
+                continue; // block members have no location, they are set through the buffer
+            }
+            glGetActiveUniform(_programID, index, sizeof(name), &length, &size, &type, name);
+
+            // arrays are reported as "name[0]", register the bare name and every element
+            std::string uniform(name, length);
+            GLint       location = glGetUniformLocation(_programID, name);
+            if (size > 1 && uniform.size() > 3 && uniform.ends_with("[0]"))
+            {
+                std::string base = uniform.substr(0, uniform.size() - 3);
+                _uniforms[base]  = {location, type, size};
+                for (GLint element = 1; element < size; ++element)
+                {
+                    std::string elementName = base + "[" + std::to_string(element) + "]";
+                    _uniforms[elementName]  = {glGetUniformLocation(_programID, elementName.c_str()), type, 1};
+                }
+            }
+            _uniforms[uniform] = {location, type, size};
+        }
+
+        // one copy per location, an array's bare name and its element 0 share theirs
+        _values.clear();
+        _valueOfLocation.clear();
+        _dirty.clear();
+        for (const auto& [uniformName, uniform] : _uniforms)
+        {
+            if (uniform.location < 0)
+            {
+                continue;
+            }
+            auto location = static_cast<size_t>(uniform.location);
+            if (location >= _valueOfLocation.size())
+            {
+                _valueOfLocation.resize(location + 1, -1);
+            }
+            if (_valueOfLocation[location] < 0)
+            {
+                _valueOfLocation[location] = static_cast<int>(_values.size());
+                _values.push_back(UniformValue());
+                _values.back().location = uniform.location;
+            }
+        }
+
+        glGetProgramiv(_programID, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+        for (GLint i = 0; i < count; ++i)
+        {
+            GLuint  index    = static_cast<GLuint>(i);
+            GLint   dataSize = 0;
+            GLsizei length   = 0;
+            glGetActiveUniformBlockName(_programID, index, sizeof(name), &length, name);
+            glGetActiveUniformBlockiv(_programID, index, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+            _uniformBlocks[std::string(name, length)] = {index, dataSize};
+        }
     }
 
 } // namespace Hub
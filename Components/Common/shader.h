@@ -1,6 +1,12 @@
 ﻿#pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -9,20 +15,112 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "shader_preprocessor.h"
+
 namespace Hub
 {
+    namespace ShaderBuild
+    {
+        enum build_t
+        {
+            Blocking, // compile and link before the constructor returns
+            Async,    // submit and return, the program is usable once ready()
+        };
+    }
+
+    namespace UniformUpdate
+    {
+        enum update_t
+        {
+            Immediate, // a changed value is uploaded by the setter, the program must be in use
+            Deferred,  // changed values are uploaded together by flush() right before the draw
+        };
+    }
+
+    // location of an active uniform, resolve once with Shader::getUniform and reuse every frame
+    struct UniformHandle
+    {
+        GLint location = -1;
+
+        bool isValid() const
+        {
+            return location >= 0;
+        }
+    };
+
     class Shader
     {
     public:
+        struct UniformInfo
+        {
+            GLint  location;
+            GLenum type;
+            GLint  size; // array length, 1 for plain uniforms
+        };
+
+        struct UniformBlockInfo
+        {
+            GLuint index;
+            GLint  dataSize;
+        };
+
+        // glUniform* calls of all shaders, elided counts writes of the value the uniform already holds
+        struct UniformStats
+        {
+            unsigned int issued = 0;
+            unsigned int elided = 0;
+        };
+
         GLuint _programID;
         Shader() = default;
         // 构造器读取并构建 着色器
-        Shader(const GLchar* vsPath, const GLchar* fsPath, const char* gsPath = nullptr);
-        // 使用程序
+        Shader(const GLchar*        vsPath,
+               const GLchar*        fsPath,
+               const char*          gsPath  = nullptr,
+               const ShaderDefines& defines = {},
+               ShaderBuild::build_t build   = ShaderBuild::Blocking);
+        // 使用程序, 异步构建未完成时使用占位程序
         void use();
 
+        // polls an async build without blocking when KHR/ARB_parallel_shader_compile is available. Uniforms set
+        // before the program is ready are dropped, so set them every frame or after ready() turned true.
+        bool ready();
+        // whether an async build is still outstanding, without polling or finishing it. Code running between
+        // use() and the draw checks this rather than ready(), which could swap the program in mid-draw.
+        bool isBuilding() const;
+
+        // rebuilds from the same files and defines in the background, the current program stays in use until
+        // pollReload() swaps the new one in. Uniform values and block bindings carry over, a failed build keeps
+        // the current program. UniformHandles must be resolved again once getGeneration() changes, no two
+        // programs share a generation.
+        bool         reload();
+        // true when a reload finished this call, whether it succeeded or not
+        bool         pollReload();
+        bool         isReloading() const;
+        unsigned int getGeneration() const;
+
+        // every file the program was built from, #include dependencies included
+        const std::vector<std::string>& getSourceFiles() const;
+
+        // deletes the shared placeholder program, must run while the context is still current
+        static void releasePlaceholder();
+
+        // every setter writes a CPU side copy of the uniform first, a write of the value it already holds issues
+        // nothing. Deferred shaders upload the changed copies in flush(), which Mesh::draw calls before drawing;
+        // code drawing on its own calls it after the last setter. use() flushes as well. Copies are only uploaded
+        // while _programID is the program in use (as GLState knows it), otherwise they stay dirty until the next
+        // use(). glUniform* calls made directly on _programID bypass the copy and can make a later setter be
+        // elided wrongly.
+        void setUniformUpdate(UniformUpdate::update_t update);
+        void flush();
+
+        // closes the per-frame uniform counters, called once per swap
+        static void                newFrame();
+        static const UniformStats& getFrameUniformStats();
+
         void checkShaderCompile(const GLuint shader, const GLchar* filePath);
-        void checkProgramLink();
+        bool checkProgramLink();
+        bool checkProgramLink(GLuint program);
 
         void setFloat(const GLchar* key, const GLfloat val);
         void setVec4(const GLchar* key, const glm::vec4& v);
@@ -32,5 +130,93 @@ namespace Hub
         void setInt(const GLchar* key, const GLint val);
         void setMatirx4(const GLchar* key, const glm::mat4& mat);
         void bindUniformBlock(const GLchar* key, unsigned int point);
+
+        // lookups go through the table filled after linking, an inactive or unknown name gives an invalid handle
+        UniformHandle           getUniform(std::string_view name) const;
+        const UniformInfo*      findUniform(std::string_view name) const;
+        const UniformBlockInfo* findUniformBlock(std::string_view name) const;
+
+        void setFloat(UniformHandle handle, const GLfloat val);
+        void setVec4(UniformHandle handle, const glm::vec4& v);
+        void setVec3(UniformHandle handle, const glm::vec3& v);
+        void setVec3(UniformHandle handle, float x, float y, float z);
+        void setVec2(UniformHandle handle, const glm::vec2& v);
+        void setInt(UniformHandle handle, const GLint val);
+        void setMatirx4(UniformHandle handle, const glm::mat4& mat);
+
+    private:
+        // heterogeneous lookup, finding a name does not build a std::string
+        struct NameHash
+        {
+            using is_transparent = void;
+            size_t operator()(std::string_view name) const
+            {
+                return std::hash<std::string_view>()(name);
+            }
+        };
+        template <typename T>
+        using NameTable = std::unordered_map<std::string, T, NameHash, std::equal_to<>>;
+
+        enum ValueKind
+        {
+            Float1,
+            Float2,
+            Float3,
+            Float4,
+            Int1,
+            Matrix4,
+        };
+
+        // CPU copy of a uniform, kind is the setter that wrote it, -1 until the first write
+        struct UniformValue
+        {
+            GLint   location = -1;
+            int     kind     = -1;
+            bool    dirty    = false;
+            GLfloat data[16];
+        };
+
+        // compile and link submitted but not checked yet
+        struct PendingBuild
+        {
+            GLuint                                program   = 0;
+            GLuint                                stages[3] = {0, 0, 0};
+            uint64_t                              key       = 0;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        // preprocesses the sources and submits a build into program, null when the cached binary was loaded
+        std::shared_ptr<PendingBuild> submit(GLuint program);
+        bool                          isComplete(const PendingBuild& build) const;
+        // checks the status of the submitted build, releases the stages and caches the binary
+        bool finish(PendingBuild& build);
+        void finishBuild();
+        void swapProgram(GLuint program);
+        void copyUniform(GLuint source, GLint from, GLint to, GLenum type);
+        // marks the value at to dirty with the old program's value at from when that one was not flushed yet
+        void keepDirtyValue(const std::vector<UniformValue>& oldValues,
+                            const std::vector<int>&          oldValueOfLocation,
+                            GLint                            from,
+                            GLint                            to);
+        // enumerates the active uniforms and blocks of the linked program and resets the uniform copies
+        void reflect();
+        void write(UniformHandle handle, ValueKind kind, const void* data, size_t size);
+        void upload(GLint location, int kind, const GLfloat* data);
+
+        NameTable<UniformInfo>      _uniforms;
+        NameTable<UniformBlockInfo> _uniformBlocks;
+
+        std::vector<UniformValue> _values;
+        std::vector<int>          _valueOfLocation; // location -> index in _values, -1 for none
+        std::vector<unsigned int> _dirty;
+        UniformUpdate::update_t   _uniformUpdate = UniformUpdate::Immediate;
+
+        std::string              _paths[3]; // vertex, fragment, geometry (may be empty)
+        ShaderDefines            _defines;
+        std::vector<std::string> _sourceFiles;
+        unsigned int             _generation = 0;
+
+        std::shared_ptr<PendingBuild> _pending; // null once built
+        std::shared_ptr<PendingBuild> _reload;
     };
 } // namespace Hub
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "shader_hot_reload.h"
+#include "file_watcher.h"
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace Hub
+{
+    namespace
+    {
+        struct Registry
+        {
+            SPFileWatcher                                         watcher;
+            std::unordered_map<std::string, std::vector<Shader*>> users;    // normalized file -> shaders
+            std::unordered_map<Shader*, std::vector<std::string>> files;    // shader -> normalized files
+            std::vector<Shader*>                                  dirty;    // waiting for a reload to start
+            std::vector<Shader*>                                  building; // reload submitted
+        };
+
+        Registry& registry()
+        {
+            static Registry s_registry;
+            return s_registry;
+        }
+
+        template <typename T>
+        void eraseValue(std::vector<T>& values, const T& value)
+        {
+            values.erase(std::remove(values.begin(), values.end(), value), values.end());
+        }
+
+        void unwatchFiles(Shader* shader)
+        {
+            auto& reg = registry();
+            auto  it  = reg.files.find(shader);
+            if (it == reg.files.end())
+            {
+                return;
+            }
+            for (const auto& file : it->second)
+            {
+                auto& users = reg.users[file];
+                eraseValue(users, shader);
+                if (users.empty())
+                {
+                    reg.users.erase(file);
+                    reg.watcher->unwatch(file);
+                }
+            }
+            reg.files.erase(it);
+        }
+
+        // the include list can change with every edit, so it is rebuilt after each reload
+        void watchFiles(Shader* shader)
+        {
+            auto& reg = registry();
+            if (!reg.watcher)
+            {
+                reg.watcher = FileWatcher::create();
+            }
+            unwatchFiles(shader);
+            auto& files = reg.files[shader];
+            for (const auto& source : shader->getSourceFiles())
+            {
+                std::string file = FileWatcher::normalize(source);
+                files.push_back(file);
+                reg.users[file].push_back(shader);
+                reg.watcher->watch(file);
+            }
+        }
+    } // namespace
+
+    void ShaderHotReload::add(Shader& shader)
+    {
+        watchFiles(&shader);
+    }
+
+    void ShaderHotReload::remove(Shader& shader)
+    {
+        auto& reg = registry();
+        unwatchFiles(&shader);
+        eraseValue(reg.dirty, &shader);
+        eraseValue(reg.building, &shader);
+    }
+
+    void ShaderHotReload::update()
+    {
+        auto& reg = registry();
+        if (!reg.watcher)
+        {
+            return;
+        }
+
+        for (const auto& file : reg.watcher->poll())
+        {
+            auto it = reg.users.find(file);
+            if (it == reg.users.end())
+            {
+                continue;
+            }
+            for (Shader* shader : it->second)
+            {
+                if (std::find(reg.dirty.begin(), reg.dirty.end(), shader) == reg.dirty.end())
+                {
+                    reg.dirty.push_back(shader);
+                }
+            }
+            std::cout << "ShaderHotReload: " << file << " changed, rebuilding " << it->second.size() << " program(s)"
+                      << std::endl;
+        }
+
+        // a shader still building its previous reload stays dirty and is picked up once that one is done
+        std::erase_if(reg.dirty, [&reg](Shader* shader) {
+            if (!shader->reload())
+            {
+                return false;
+            }
+            if (shader->isReloading())
+            {
+                reg.building.push_back(shader);
+            }
+            else
+            {
+                watchFiles(shader);
+            }
+            return true;
+        });
+
+        std::erase_if(reg.building, [](Shader* shader) {
+            if (!shader->pollReload())
+            {
+                return false;
+            }
+            watchFiles(shader);
+            return true;
+        });
+    }
+
+    void ShaderHotReload::clear()
+    {
+        registry() = Registry();
+    }
+} // namespace Hub
@@ -0,0 +1,21 @@
+#pragma once
+#include "utils.h"
+#include "shader.h"
+
+namespace Hub
+{
+    // Watches the source files of registered shaders, #include dependencies included, and rebuilds only the
+    // programs that use a file when it changes. Rebuilds run in the background and are swapped in once linked,
+    // see Shader::reload. Shaders must be removed before they are destroyed, Window::destroy clears the list.
+    class ShaderHotReload
+    {
+    public:
+        static void add(Shader& shader);
+        static void remove(Shader& shader);
+
+        // starts the rebuilds for changed files and swaps in the finished ones, called per swap
+        static void update();
+
+        static void clear();
+    };
+} // namespace Hub
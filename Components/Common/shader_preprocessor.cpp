@@ -0,0 +1,149 @@
+#include "shader_preprocessor.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace Hub
+{
+    namespace
+    {
+        const int MaxIncludeDepth = 32;
+
+        bool readFile(const std::string& path, std::string& text)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+            {
+                return false;
+            }
+            std::stringstream stream;
+            stream << file.rdbuf();
+            text = stream.str();
+            // most of our shaders are saved with a UTF-8 BOM, which is not valid GLSL in the middle of a source
+            if (text.compare(0, 3, "\xEF\xBB\xBF") == 0)
+            {
+                text.erase(0, 3);
+            }
+            return true;
+        }
+
+        std::string trimLeft(const std::string& line)
+        {
+            auto first = line.find_first_not_of(" \t");
+            return first == std::string::npos ? std::string() : line.substr(first);
+        }
+
+        // "#include "a.glsl"" or "#include <a.glsl>" -> a.glsl, empty when the line is not an include
+        std::string includeTarget(const std::string& line)
+        {
+            std::string directive = trimLeft(line);
+            if (directive.compare(0, 8, "#include") != 0)
+            {
+                return std::string();
+            }
+            auto open = directive.find_first_of("\"<", 8);
+            if (open == std::string::npos)
+            {
+                return std::string();
+            }
+            auto close = directive.find(directive[open] == '"' ? '"' : '>', open + 1);
+            if (close == std::string::npos)
+            {
+                return std::string();
+            }
+            return directive.substr(open + 1, close - open - 1);
+        }
+
+        struct Context
+        {
+            const ShaderDefines& defines;
+            ShaderSource&        source;
+        };
+
+        void expand(Context& context, const std::string& path, int depth)
+        {
+            auto& source = context.source;
+            std::string text;
+            if (!readFile(path, text))
+            {
+                std::cout << "ERROR::SHADER::FILE_NOT_SUCCEDDFULLY_READ: " << path << std::endl;
+                source.valid = false;
+                return;
+            }
+            size_t fileIndex = source.files.size();
+            source.files.push_back(path);
+            if (depth == 0 && text.find("#version") == std::string::npos)
+            {
+                for (const auto& [name, value] : context.defines)
+                {
+                    source.code += "#define " + name + (value.empty() ? "" : " " + value) + "\n";
+                }
+            }
+
+            std::istringstream stream(text);
+            std::string        line;
+            size_t             lineNumber = 0;
+            while (std::getline(stream, line))
+            {
+                ++lineNumber;
+                if (!line.empty() && line.back() == '\r')
+                {
+                    line.pop_back();
+                }
+
+                if (depth == 0 && trimLeft(line).compare(0, 8, "#version") == 0)
+                {
+                    source.code += line + "\n";
+                    for (const auto& [name, value] : context.defines)
+                    {
+                        source.code += "#define " + name + (value.empty() ? "" : " " + value) + "\n";
+                    }
+                    source.code += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+                    continue;
+                }
+
+                std::string target = includeTarget(line);
+                if (target.empty())
+                {
+                    source.code += line + "\n";
+                    continue;
+                }
+
+                auto include = (std::filesystem::path(path).parent_path() / target).lexically_normal().string();
+                if (depth + 1 >= MaxIncludeDepth)
+                {
+                    std::cout << "ERROR::SHADER::INCLUDE:: too deep at " << include << std::endl;
+                    source.valid = false;
+                    return;
+                }
+                // include once, a second #include of the same file is dropped
+                if (std::find(source.files.begin(), source.files.end(), include) == source.files.end())
+                {
+                    source.code += "#line 1 " + std::to_string(source.files.size()) + "\n";
+                    expand(context, include, depth + 1);
+                    source.code += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+                }
+            }
+        }
+    } // namespace
+
+    ShaderSource ShaderPreprocessor::load(const std::string& path, const ShaderDefines& defines)
+    {
+        ShaderSource source;
+        Context      context{defines, source};
+        expand(context, path, 0);
+        return source;
+    }
+
+    std::string ShaderPreprocessor::makeKey(const ShaderDefines& defines)
+    {
+        std::string key;
+        for (const auto& [name, value] : defines)
+        {
+            key += name + (value.empty() ? "" : "=" + value) + ";";
+        }
+        return key;
+    }
+} // namespace Hub
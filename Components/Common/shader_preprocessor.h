@@ -0,0 +1,30 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Hub
+{
+    // name -> value, an empty value gives a keyword define ("#define SHADOWS"). Ordered, so the same set always
+    // produces the same source and the same variant key.
+    using ShaderDefines = std::map<std::string, std::string>;
+
+    struct ShaderSource
+    {
+        std::string              code;
+        std::vector<std::string> files; // the root file first, then every file it included
+        bool                     valid = true;
+    };
+
+    // Expands #include "file" (relative to the including file, each file included once) and injects the
+    // defines right after #version. #line directives keep compile errors pointing at the right line, the
+    // source string number is the index in ShaderSource::files.
+    class ShaderPreprocessor
+    {
+    public:
+        static ShaderSource load(const std::string& path, const ShaderDefines& defines = {});
+
+        // stable text form of a define set, "A;B=4;"
+        static std::string makeKey(const ShaderDefines& defines);
+    };
+} // namespace Hub
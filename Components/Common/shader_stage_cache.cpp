@@ -0,0 +1,68 @@
+#include "shader_stage_cache.h"
+#include <unordered_map>
+
+namespace Hub
+{
+    namespace
+    {
+        struct Stage
+        {
+            GLuint      shader = 0;
+            std::string code;
+        };
+
+        struct Cache
+        {
+            std::unordered_map<std::string, Stage> stages; // "type|path|defines"
+            ShaderStageCache::Stats                stats;
+        };
+
+        Cache& cache()
+        {
+            static Cache s_cache;
+            return s_cache;
+        }
+    } // namespace
+
+    GLuint ShaderStageCache::get(GLenum               type,
+                                 const std::string&   path,
+                                 const ShaderDefines& defines,
+                                 const std::string&   code)
+    {
+        auto& c     = cache();
+        auto  key   = std::to_string(type) + "|" + path + "|" + ShaderPreprocessor::makeKey(defines);
+        auto& stage = c.stages[key];
+        if (stage.shader != 0 && stage.code == code)
+        {
+            ++c.stats.reused;
+            return stage.shader;
+        }
+
+        // programs still holding the old object keep it alive until they are deleted or detach it
+        if (stage.shader != 0)
+        {
+            glDeleteShader(stage.shader);
+        }
+        const GLchar* source = code.c_str();
+        stage.shader         = glCreateShader(type);
+        stage.code           = code;
+        glShaderSource(stage.shader, 1, &source, nullptr);
+        glCompileShader(stage.shader);
+        ++c.stats.compiled;
+        return stage.shader;
+    }
+
+    const ShaderStageCache::Stats& ShaderStageCache::getStats()
+    {
+        return cache().stats;
+    }
+
+    void ShaderStageCache::clear()
+    {
+        for (const auto& [key, stage] : cache().stages)
+        {
+            glDeleteShader(stage.shader);
+        }
+        cache().stages.clear();
+    }
+} // namespace Hub
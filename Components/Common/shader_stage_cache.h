@@ -0,0 +1,29 @@
+#pragma once
+#include "utils.h"
+#include "shader_preprocessor.h"
+#include <string>
+
+namespace Hub
+{
+    // Compiled shader objects shared between programs. A stage is keyed by its type, path and define set, so a
+    // vertex shader used by several programs is compiled once and attached to each of them. The preprocessed
+    // code is compared on every lookup: an edited file compiles a new object that replaces the old one.
+    class ShaderStageCache
+    {
+    public:
+        struct Stats
+        {
+            uint compiled = 0;
+            uint reused   = 0;
+        };
+
+        // the compile is submitted but its status is not queried, callers check it once the program is linked.
+        // The object stays owned by the cache, detach it after linking instead of deleting it.
+        static GLuint get(GLenum type, const std::string& path, const ShaderDefines& defines, const std::string& code);
+
+        static const Stats& getStats();
+
+        // deletes every cached object, must run while the context is still current
+        static void clear();
+    };
+} // namespace Hub
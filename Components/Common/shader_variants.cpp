@@ -0,0 +1,31 @@
+#include "shader_variants.h"
+
+namespace Hub
+{
+    SPShaderVariants ShaderVariants::create(const std::string& vsPath,
+                                            const std::string& fsPath,
+                                            const std::string& gsPath)
+    {
+        return SPShaderVariants(new ShaderVariants(vsPath, fsPath, gsPath));
+    }
+
+    Shader& ShaderVariants::get(const ShaderDefines& defines)
+    {
+        auto& variant = _variants[ShaderPreprocessor::makeKey(defines)];
+        if (!variant)
+        {
+            const char* gsPath = _gsPath.empty() ? nullptr : _gsPath.c_str();
+            variant = std::make_unique<Shader>(_vsPath.c_str(), _fsPath.c_str(), gsPath, defines);
+        }
+        return *variant;
+    }
+
+    uint ShaderVariants::getVariantCount() const
+    {
+        return static_cast<uint>(_variants.size());
+    }
+
+    ShaderVariants::ShaderVariants(const std::string& vsPath, const std::string& fsPath, const std::string& gsPath) :
+        _vsPath(vsPath), _fsPath(fsPath), _gsPath(gsPath)
+    {}
+} // namespace Hub
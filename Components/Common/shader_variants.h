@@ -0,0 +1,37 @@
+#pragma once
+#include "utils.h"
+#include "shader.h"
+#include "shader_preprocessor.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace Hub
+{
+    class ShaderVariants;
+    using SPShaderVariants = std::shared_ptr<ShaderVariants>;
+
+    // One shader program and every permutation of its defines. A variant is compiled the first time it is
+    // asked for and kept, so features are switched per draw by picking a variant instead of branching on a
+    // uniform in the shader.
+    class ShaderVariants
+    {
+    public:
+        static SPShaderVariants create(const std::string& vsPath,
+                                       const std::string& fsPath,
+                                       const std::string& gsPath = std::string());
+
+        Shader& get(const ShaderDefines& defines = {});
+
+        uint getVariantCount() const;
+
+    private:
+        ShaderVariants(const std::string& vsPath, const std::string& fsPath, const std::string& gsPath);
+
+        std::string _vsPath;
+        std::string _fsPath;
+        std::string _gsPath;
+
+        std::unordered_map<std::string, std::unique_ptr<Shader>> _variants; // ShaderPreprocessor::makeKey
+    };
+} // namespace Hub
@@ -0,0 +1,221 @@
+#pragma once
+#include "gmath.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+namespace Hub
+{
+    // std140 uniform block layout for C++ structs.
+    // Members use the types below, which carry the std140 base alignment, so a struct mirrors the GLSL block:
+    //   struct Matrices : Std140::Block
+    //   {
+    //       Std140::Mat4 projection;
+    //       Std140::Mat4 view;
+    //   };
+    //   HUB_STD140_BLOCK(Matrices, projection, view);
+    // HUB_STD140_BLOCK recomputes every offset with the std140 rules and fails to compile when the C++ layout
+    // differs, e.g. a scalar that GLSL packs into the last 4 bytes of a vec3.
+    namespace Std140
+    {
+        constexpr size_t alignUp(size_t value, size_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        // Alignment is the std140 base alignment, Size the bytes GLSL consumes (a vec3 is 12)
+        template <typename T, size_t Alignment, size_t Size = sizeof(T)>
+        struct alignas(Alignment) Value
+        {
+            static constexpr size_t alignment = Alignment;
+            static constexpr size_t size      = Size;
+
+            T value{};
+
+            Value() = default;
+            Value(const T& v) : value(v) {}
+
+            Value& operator=(const T& v)
+            {
+                value = v;
+                return *this;
+            }
+
+            operator const T&() const
+            {
+                return value;
+            }
+        };
+
+        using Float = Value<float, 4>;
+        using Int   = Value<int32_t, 4>;
+        using UInt  = Value<uint32_t, 4>;
+        using Bool  = Value<int32_t, 4>; // GLSL bools are 4 bytes
+        using Vec2  = Value<Vector2, 8>;
+        using Vec3  = Value<Vector3, 16, 12>;
+        using Vec4  = Value<Vector4, 16>;
+        using Mat4  = Value<Matrix4, 16>;
+
+        // a mat3 is stored as three vec4 columns
+        struct alignas(16) Mat3
+        {
+            static constexpr size_t alignment = 16;
+            static constexpr size_t size      = 48;
+
+            Vector4 columns[3];
+
+            Mat3() = default;
+            Mat3(const Matrix3& m)
+            {
+                *this = m;
+            }
+
+            Mat3& operator=(const Matrix3& m)
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    columns[i] = Vector4(m[i], 0.f);
+                }
+                return *this;
+            }
+        };
+
+        // base of every block struct, blocks nested in other blocks or arrays are 16 aligned and padded
+        struct alignas(16) Block
+        {};
+
+        template <typename T>
+        constexpr size_t alignmentOf()
+        {
+            if constexpr (std::is_base_of_v<Block, T>)
+            {
+                return 16;
+            }
+            else
+            {
+                return T::alignment;
+            }
+        }
+
+        template <typename T>
+        constexpr size_t sizeOf()
+        {
+            if constexpr (std::is_base_of_v<Block, T>)
+            {
+                return alignUp(sizeof(T), 16);
+            }
+            else
+            {
+                return T::size;
+            }
+        }
+
+        // array elements are rounded up to a vec4 stride
+        template <typename T, size_t N>
+        struct alignas(16) Array
+        {
+            static constexpr size_t stride    = alignUp(sizeOf<T>(), 16);
+            static constexpr size_t alignment = 16;
+            static constexpr size_t size      = stride * N;
+
+            struct alignas(16) Element
+            {
+                T value;
+            };
+            Element elements[N];
+
+            T& operator[](size_t index)
+            {
+                return elements[index].value;
+            }
+
+            const T& operator[](size_t index) const
+            {
+                return elements[index].value;
+            }
+        };
+
+        // std140 offsets of a block whose members have the given types
+        template <typename... Members>
+        struct Layout
+        {
+            static constexpr std::array<size_t, sizeof...(Members)> offsets = [] {
+                std::array<size_t, sizeof...(Members)> result{};
+                size_t                                 offset = 0;
+                size_t                                 index  = 0;
+                ((offset = alignUp(offset, alignmentOf<Members>()), result[index++] = offset,
+                  offset += sizeOf<Members>()),
+                 ...);
+                return result;
+            }();
+
+            static constexpr size_t end = [] {
+                size_t offset = 0;
+                ((offset = alignUp(offset, alignmentOf<Members>()) + sizeOf<Members>()), ...);
+                return offset;
+            }();
+
+            static constexpr bool matches(std::initializer_list<size_t> actual)
+            {
+                size_t index = 0;
+                for (size_t offset : actual)
+                {
+                    if (offset != offsets[index++])
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        };
+    } // namespace Std140
+} // namespace Hub
+
+// helpers for HUB_STD140_BLOCK, up to 16 members
+#define HUB_STD140_EXPAND(x) x
+#define HUB_STD140_PICK(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, NAME, ...) NAME
+#define HUB_STD140_EACH_1(f, T, m) f(T, m)
+#define HUB_STD140_EACH_2(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_1(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_3(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_2(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_4(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_3(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_5(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_4(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_6(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_5(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_7(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_6(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_8(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_7(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_9(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_8(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_10(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_9(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_11(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_10(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_12(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_11(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_13(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_12(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_14(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_13(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_15(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_14(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH_16(f, T, m, ...) f(T, m), HUB_STD140_EXPAND(HUB_STD140_EACH_15(f, T, __VA_ARGS__))
+#define HUB_STD140_EACH(f, T, ...)                                                                                 \
+    HUB_STD140_EXPAND(HUB_STD140_PICK(__VA_ARGS__,                                                                 \
+                                      HUB_STD140_EACH_16,                                                          \
+                                      HUB_STD140_EACH_15,                                                          \
+                                      HUB_STD140_EACH_14,                                                          \
+                                      HUB_STD140_EACH_13,                                                          \
+                                      HUB_STD140_EACH_12,                                                          \
+                                      HUB_STD140_EACH_11,                                                          \
+                                      HUB_STD140_EACH_10,                                                          \
+                                      HUB_STD140_EACH_9,                                                           \
+                                      HUB_STD140_EACH_8,                                                           \
+                                      HUB_STD140_EACH_7,                                                           \
+                                      HUB_STD140_EACH_6,                                                           \
+                                      HUB_STD140_EACH_5,                                                           \
+                                      HUB_STD140_EACH_4,                                                           \
+                                      HUB_STD140_EACH_3,                                                           \
+                                      HUB_STD140_EACH_2,                                                           \
+                                      HUB_STD140_EACH_1)(f, T, __VA_ARGS__))
+#define HUB_STD140_TYPE(T, m) decltype(T::m)
+#define HUB_STD140_OFFSET(T, m) offsetof(T, m)
+
+#define HUB_STD140_BLOCK(T, ...)                                                                                   \
+    static_assert(::Hub::Std140::Layout<HUB_STD140_EACH(HUB_STD140_TYPE, T, __VA_ARGS__)>::matches(               \
+                      {HUB_STD140_EACH(HUB_STD140_OFFSET, T, __VA_ARGS__)}),                                       \
+                  #T " does not match the std140 layout");                                                         \
+    static_assert(sizeof(T) >= ::Hub::Std140::Layout<HUB_STD140_EACH(HUB_STD140_TYPE, T, __VA_ARGS__)>::end,      \
+                  #T " is smaller than its std140 block")
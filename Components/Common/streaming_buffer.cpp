@@ -0,0 +1,226 @@
+#include "streaming_buffer.h"
+#include "gl_extensions.h"
+#include <cstring>
+
+namespace Hub
+{
+    static const GLuint64 s_fenceTimeout = 1000000; // 1ms per wait, retried until signaled
+
+    SPStreamingBuffer StreamingBuffer::create(buffer_t bufferType, size_t frameSize, uint frameCount)
+    {
+        return SPStreamingBuffer(new StreamingBuffer(bufferType, frameSize, frameCount));
+    }
+
+    StreamingBuffer::StreamingBuffer(buffer_t bufferType, size_t frameSize, uint frameCount) :
+        Buffer(bufferType), _frameSize(frameSize), _frameCount(frameCount), _fences(frameCount, nullptr)
+    {
+        size_t totalSize = _frameSize * _frameCount;
+        _persistent      = GLExtensions::get().bufferStorage;
+
+        if (_persistent)
+        {
+            GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            if (_dsa)
+            {
+                glNamedBufferStorage(_obj, totalSize, nullptr, flags);
+                _mapped = static_cast<unsigned char*>(glMapNamedBufferRange(_obj, 0, totalSize, flags));
+            }
+            else
+            {
+                GLenum target = bindForEdit();
+                glBufferStorage(target, totalSize, nullptr, flags);
+                _mapped = static_cast<unsigned char*>(glMapBufferRange(target, 0, totalSize, flags));
+            }
+            if (!_mapped)
+            {
+                std::cerr << "StreamingBuffer: persistent map failed" << std::endl;
+            }
+        }
+        else
+        {
+            Buffer::data(nullptr, totalSize, BufferUsage::StreamDraw);
+        }
+    }
+
+    StreamingBuffer::~StreamingBuffer()
+    {
+        if (_mapped)
+        {
+            unmap();
+        }
+        for (auto& fence : _fences)
+        {
+            if (fence)
+            {
+                glDeleteSync(fence);
+            }
+        }
+    }
+
+    void StreamingBuffer::beginFrame()
+    {
+        _head    = 0;
+        _flushed = false;
+        if (_persistent)
+        {
+            waitFence(_frameIndex);
+            return;
+        }
+
+        // 3.3 path: never block on the GPU, hand the old storage to the driver and start over
+        GLsync& fence = _fences[_frameIndex];
+        if (fence)
+        {
+            GLenum result = glClientWaitSync(fence, 0, 0);
+            if (result == GL_TIMEOUT_EXPIRED)
+            {
+                orphan();
+            }
+            else
+            {
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+
+        GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                            GL_MAP_FLUSH_EXPLICIT_BIT;
+        if (_dsa)
+        {
+            _mapped = static_cast<unsigned char*>(glMapNamedBufferRange(_obj, getFrameOffset(), _frameSize, access));
+        }
+        else
+        {
+            GLenum target = bindForEdit();
+            _mapped = static_cast<unsigned char*>(glMapBufferRange(target, getFrameOffset(), _frameSize, access));
+        }
+    }
+
+    StreamingBuffer::Allocation StreamingBuffer::allocate(size_t length, size_t alignment)
+    {
+        Allocation allocation;
+        size_t     start = (_head + alignment - 1) / alignment * alignment;
+        if (!_mapped || start + length > _frameSize)
+        {
+            std::cerr << "StreamingBuffer: frame region exhausted, requested " << length << " bytes" << std::endl;
+            return allocation;
+        }
+
+        size_t regionStart = _persistent ? getFrameOffset() : 0;
+        allocation.ptr     = _mapped + regionStart + start;
+        allocation.offset  = getFrameOffset() + start;
+        allocation.length  = length;
+        _head              = start + length;
+        return allocation;
+    }
+
+    StreamingBuffer::Allocation StreamingBuffer::write(const void* data, size_t length, size_t alignment)
+    {
+        auto allocation = allocate(length, alignment);
+        if (allocation.ptr)
+        {
+            std::memcpy(allocation.ptr, data, length);
+        }
+        return allocation;
+    }
+
+    void StreamingBuffer::flush()
+    {
+        if (_flushed)
+        {
+            return;
+        }
+        _flushed = true;
+        if (_persistent || !_mapped)
+        {
+            // coherent mapping, writes are visible to the next draw
+            return;
+        }
+        if (_head > 0)
+        {
+            if (_dsa)
+            {
+                glFlushMappedNamedBufferRange(_obj, 0, _head);
+            }
+            else
+            {
+                glFlushMappedBufferRange(bindForEdit(), 0, _head);
+            }
+        }
+        unmap();
+    }
+
+    void StreamingBuffer::endFrame()
+    {
+        flush();
+        GLsync& fence = _fences[_frameIndex];
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+        fence       = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        _frameIndex = (_frameIndex + 1) % _frameCount;
+    }
+
+    bool StreamingBuffer::isPersistent() const
+    {
+        return _persistent;
+    }
+
+    size_t StreamingBuffer::getFrameSize() const
+    {
+        return _frameSize;
+    }
+
+    size_t StreamingBuffer::getFrameOffset() const
+    {
+        return _frameIndex * _frameSize;
+    }
+
+    size_t StreamingBuffer::getUsedSize() const
+    {
+        return _head;
+    }
+
+    void StreamingBuffer::waitFence(uint frameIndex)
+    {
+        GLsync& fence = _fences[frameIndex];
+        if (!fence)
+        {
+            return;
+        }
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, s_fenceTimeout);
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, s_fenceTimeout);
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    void StreamingBuffer::unmap()
+    {
+        if (_dsa)
+        {
+            glUnmapNamedBuffer(_obj);
+        }
+        else
+        {
+            glUnmapBuffer(bindForEdit());
+        }
+        _mapped = nullptr;
+    }
+
+    void StreamingBuffer::orphan()
+    {
+        Buffer::data(nullptr, _frameSize * _frameCount, BufferUsage::StreamDraw);
+        for (auto& fence : _fences)
+        {
+            if (fence)
+            {
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+    }
+} // namespace Hub
@@ -0,0 +1,64 @@
+#pragma once
+#include "utils.h"
+#include "buffer.h"
+#include <memory>
+#include <vector>
+
+namespace Hub
+{
+    class StreamingBuffer;
+    using SPStreamingBuffer = std::shared_ptr<StreamingBuffer>;
+
+    // Ring of frameCount regions for per-frame dynamic data. Each frame writes straight into mapped
+    // memory and the region is fenced once submitted, so the CPU never overwrites data in flight.
+    //   beginFrame() -> allocate()... -> flush() -> draw -> endFrame()
+    // With buffer storage the whole ring stays persistently mapped; on a plain 3.3 context the
+    // current region is mapped unsynchronized and the buffer is orphaned instead of stalling.
+    class StreamingBuffer final : public Buffer
+    {
+    public:
+        struct Allocation
+        {
+            void*  ptr    = nullptr;
+            size_t offset = 0; // offset from the start of the buffer, usable for draws and bindBufferRange
+            size_t length = 0;
+        };
+
+        static SPStreamingBuffer create(buffer_t bufferType, size_t frameSize, uint frameCount = 3);
+
+        ~StreamingBuffer();
+
+        void       beginFrame();
+        Allocation allocate(size_t length, size_t alignment = 4);
+        Allocation write(const void* data, size_t length, size_t alignment = 4);
+        void       flush();
+        void       endFrame();
+
+        bool   isPersistent() const;
+        size_t getFrameSize() const;
+        size_t getFrameOffset() const;
+        size_t getUsedSize() const;
+
+    private:
+        StreamingBuffer(buffer_t bufferType, size_t frameSize, uint frameCount);
+
+        // immutable storage must not be respecified
+        using Buffer::data;
+        using Buffer::getSubData;
+        using Buffer::subData;
+
+        void waitFence(uint frameIndex);
+        void unmap();
+        void orphan();
+
+        size_t _frameSize;
+        uint   _frameCount;
+        uint   _frameIndex = 0;
+        size_t _head       = 0;
+        bool   _persistent = false;
+        bool   _flushed    = true;
+
+        unsigned char*      _mapped = nullptr; // whole ring when persistent, current region otherwise
+        std::vector<GLsync> _fences;
+    };
+} // namespace Hub
@@ -1,10 +1,14 @@
 #include "texture.h"
+#include "gl_state.h"
+#include "gl_extensions.h"
+#include "gl_deletion_queue.h"
 
 namespace Hub
 {
     Texture::~Texture()
     {
-        glDeleteTextures(1, &_obj);
+        GLState::onDeleteTexture(_obj);
+        GLDeletionQueue::release(GLObject::Texture, _obj);
     }
 
     Texture::operator GLuint() const
@@ -35,43 +39,58 @@ namespace Hub
 
     void Texture::setWrapping(Wrapping::axis_t axis, Wrapping::wrapping_t wrapping)
     {
-        glBindTexture(_textureType, _obj);
+        if (_dsa)
+        {
+            glTextureParameteri(_obj, axis, wrapping);
+            return;
+        }
+        GLState::bindTexture(_textureType, _obj);
         glTexParameteri(_textureType, axis, wrapping);
-        glBindTexture(_textureType, 0);
     }
 
     void Texture::setFilter(Filter::operator_t op, Filter::filter_t flt)
     {
-        glBindTexture(_textureType, _obj);
+        if (_dsa)
+        {
+            glTextureParameteri(_obj, op, flt);
+            return;
+        }
+        GLState::bindTexture(_textureType, _obj);
         glTexParameteri(_textureType, op, flt);
-        glBindTexture(_textureType, 0);
     }
 
     void Texture::setBorderColor(const Color& color)
     {
-        glBindTexture(GL_TEXTURE_2D, _obj);
-        glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, color_ptr(color));
-        glBindTexture(GL_TEXTURE_2D, 0);
+        if (_dsa)
+        {
+            glTextureParameterfv(_obj, GL_TEXTURE_BORDER_COLOR, color_ptr(color));
+            return;
+        }
+        GLState::bindTexture(_textureType, _obj);
+        glTexParameterfv(_textureType, GL_TEXTURE_BORDER_COLOR, color_ptr(color));
     }
 
     void Texture::image2D(const void* data, Format::format_t format, int width, int height, Type::type_t dataType)
     {
-        glBindTexture(GL_TEXTURE_2D, _obj);
+        GLState::bindTexture(GL_TEXTURE_2D, _obj);
         glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, dataType, data);
-        glBindTexture(GL_TEXTURE_2D, 0);
     }
 
     void Texture::generateMipMap()
     {
-        glBindTexture(GL_TEXTURE_2D, _obj);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        if (_dsa)
+        {
+            glGenerateTextureMipmap(_obj);
+            return;
+        }
+        GLState::bindTexture(_textureType, _obj);
+        glGenerateMipmap(_textureType);
     }
 
     void Texture::cubeMapImage2D(const std::vector<std::string>& faces)
     {
         assert(faces.size() == 6);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, _obj);
+        GLState::bindTexture(GL_TEXTURE_CUBE_MAP, _obj);
         for (size_t i = 0; i < faces.size(); ++i)
         {
             const auto&      filePath = faces[i];
@@ -87,12 +106,11 @@ namespace Hub
                          Type::UnsignedByte,
                          image->getData());
         }
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
     }
 
     void Texture::cubeMapImage2D(int width, int height)
     {
-        glBindTexture(GL_TEXTURE_CUBE_MAP, _obj);
+        GLState::bindTexture(GL_TEXTURE_CUBE_MAP, _obj);
         for (size_t i = 0; i < 6; ++i)
         {
 
@@ -106,19 +124,26 @@ namespace Hub
                          Type::UnsignedByte,
                          nullptr);
         }
-        glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
     }
 
-    void Texture::image2DMultisample(int width, int height)
+    void Texture::image2DMultisample(int width, int height, int samples, Format::format_t format)
     {
-        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, _obj);
-        glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, 4, GL_RGB, width, height, GL_TRUE);
-        glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+        GLState::bindTexture(GL_TEXTURE_2D_MULTISAMPLE, _obj);
+        glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, samples, format, width, height, GL_TRUE);
     }
 
-    Texture::Texture(texture_t type = Texture2D) : _textureType(type)
+    Texture::Texture(texture_t type = Texture2D) :
+        _textureType(type), _dsa(GLExtensions::get().directStateAccess)
     {
-        glGenTextures(1, &_obj);
+        if (_dsa)
+        {
+            // named textures get their target at creation
+            glCreateTextures(_textureType, 1, &_obj);
+        }
+        else
+        {
+            glGenTextures(1, &_obj);
+        }
     }
 
     Texture::Texture(const SPImage image) : Texture()
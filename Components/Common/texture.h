@@ -61,8 +61,9 @@ namespace Hub
 
     enum texture_t
     {
-        Texture2D      = GL_TEXTURE_2D,
-        TextureCubeMap = GL_TEXTURE_CUBE_MAP,
+        Texture2D            = GL_TEXTURE_2D,
+        TextureCubeMap       = GL_TEXTURE_CUBE_MAP,
+        Texture2DMultisample = GL_TEXTURE_2D_MULTISAMPLE,
 
     };
 
@@ -88,13 +89,16 @@ namespace Hub
 
         void cubeMapImage2D(const std::vector<std::string>& faces);
         void cubeMapImage2D(int width, int height);
-        void image2DMultisample(int width, int height);
+        void image2DMultisample(int width, int height, int samples = 4, Format::format_t format = Format::RGB);
 
     private:
+        template <typename>
+        friend class HandlePool;
         texture_t _textureType;
         Texture(texture_t type);
         Texture(const SPImage image);
         Format::format_t getDefaultFormat(int channelCount = 4);
         GLuint           _obj;
+        bool             _dsa; // created with glCreateTextures, parameters are set without binding
     };
 } // namespace Hub
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "texture_loader.h"
+#include "thread_pool.h"
+#include <chrono>
+
+namespace Hub
+{
+    SPTextureLoader TextureLoader::create(Setup setup)
+    {
+        return SPTextureLoader(new TextureLoader(std::move(setup)));
+    }
+
+    void TextureLoader::request(const std::string& path)
+    {
+        if (!_textures.emplace(path, nullptr).second)
+        {
+            return;
+        }
+        // stb_image only reads the flip flag, decoding on the workers is safe
+        _pending.push_back({path, ThreadPool::submit([path]() { return Image::create(path.c_str()); })});
+    }
+
+    void TextureLoader::finish()
+    {
+        // upload in completion order, so the GL thread works while the slower files are still decoding
+        while (!_pending.empty())
+        {
+            bool uploaded = false;
+            for (size_t i = 0; i < _pending.size();)
+            {
+                if (_pending[i].image.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    upload(_pending[i]);
+                    _pending[i] = std::move(_pending.back());
+                    _pending.pop_back();
+                    uploaded = true;
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            if (!uploaded)
+            {
+                upload(_pending.back());
+                _pending.pop_back();
+            }
+        }
+    }
+
+    SPTexture TextureLoader::get(const std::string& path) const
+    {
+        auto it = _textures.find(path);
+        return it != _textures.end() ? it->second : nullptr;
+    }
+
+    uint TextureLoader::getTextureCount() const
+    {
+        return static_cast<uint>(_textures.size());
+    }
+
+    TextureLoader::TextureLoader(Setup setup) : _setup(std::move(setup)) {}
+
+    void TextureLoader::upload(Pending& pending)
+    {
+        auto texture = Texture::create(pending.image.get());
+        if (_setup)
+        {
+            _setup(*texture);
+        }
+        _textures[pending.path] = texture;
+    }
+} // namespace Hub
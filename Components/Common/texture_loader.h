@@ -0,0 +1,56 @@
+#pragma once
+#include "utils.h"
+#include "image.h"
+#include "texture.h"
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Hub
+{
+    class TextureLoader;
+    using SPTextureLoader = std::shared_ptr<TextureLoader>;
+
+    // Decodes image files on the ThreadPool and creates their textures on the GL thread. Requests are
+    // deduplicated by path, each file is decoded and uploaded once however many materials use it, so a batch
+    // takes about as long as its slowest image instead of the sum.
+    //   request()... -> (other GL work while the workers decode) -> finish() -> get()
+    class TextureLoader
+    {
+    public:
+        // applied to every texture after its upload, e.g. wrapping and filters
+        using Setup = std::function<void(Texture& texture)>;
+
+        static SPTextureLoader create(Setup setup = nullptr);
+
+        // starts decoding unless path was requested before, never blocks
+        void request(const std::string& path);
+
+        // uploads the images as their decodes complete and returns once every request has its texture, must be
+        // called on the GL thread
+        void finish();
+
+        // nullptr for a path that was never requested or not finished yet
+        SPTexture get(const std::string& path) const;
+
+        uint getTextureCount() const;
+
+    private:
+        struct Pending
+        {
+            std::string          path;
+            std::future<SPImage> image;
+        };
+
+        TextureLoader(Setup setup);
+
+        void upload(Pending& pending);
+
+        Setup                                      _setup;
+        std::vector<Pending>                       _pending;
+        std::unordered_map<std::string, SPTexture> _textures; // null while the decode is pending
+    };
+} // namespace Hub
@@ -0,0 +1,116 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Hub
+{
+    namespace
+    {
+        struct Pool
+        {
+            std::vector<std::thread>          workers;
+            std::deque<std::function<void()>> tasks;
+            std::mutex                        mutex;
+            std::condition_variable           wake;
+            bool                              stopping = false;
+
+            Pool()
+            {
+                // hardware_concurrency may report 0, keep at least one worker
+                uint count = std::max(2u, std::thread::hardware_concurrency()) - 1;
+                for (uint i = 0; i < count; ++i)
+                {
+                    workers.emplace_back([this]() { run(); });
+                }
+            }
+
+            ~Pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                for (auto& worker : workers)
+                {
+                    worker.join();
+                }
+            }
+
+            void run()
+            {
+                while (true)
+                {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        wake.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                        if (tasks.empty())
+                        {
+                            return; // stopping, queued tasks are drained first
+                        }
+                        task = std::move(tasks.front());
+                        tasks.pop_front();
+                    }
+                    task();
+                }
+            }
+        };
+
+        Pool& pool()
+        {
+            static Pool s_pool;
+            return s_pool;
+        }
+    } // namespace
+
+    void ThreadPool::parallelFor(uint count, const std::function<void(uint index)>& body)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        // every participant pulls the next index until none are left, so uneven items balance themselves
+        std::atomic<uint> next{0};
+        auto              work = [&]() {
+            for (uint index = next++; index < count; index = next++)
+            {
+                body(index);
+            }
+        };
+
+        uint                           helpers = std::min(count - 1, getWorkerCount());
+        std::vector<std::future<void>> done;
+        done.reserve(helpers);
+        for (uint i = 0; i < helpers; ++i)
+        {
+            done.push_back(submit(work));
+        }
+        work();
+        for (auto& future : done)
+        {
+            future.get();
+        }
+    }
+
+    uint ThreadPool::getWorkerCount()
+    {
+        return static_cast<uint>(pool().workers.size());
+    }
+
+    void ThreadPool::enqueue(std::function<void()> task)
+    {
+        auto& p = pool();
+        {
+            std::lock_guard<std::mutex> lock(p.mutex);
+            p.tasks.push_back(std::move(task));
+        }
+        p.wake.notify_one();
+    }
+} // namespace Hub
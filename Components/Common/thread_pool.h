@@ -0,0 +1,34 @@
+#pragma once
+#include "utils.h"
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+namespace Hub
+{
+    // Process wide worker threads for CPU work that must not touch GL: asset conversion, image decoding.
+    // Workers start on the first use, one per hardware thread minus the render thread, and are joined at exit.
+    class ThreadPool
+    {
+    public:
+        template <typename F>
+        static std::future<std::invoke_result_t<F>> submit(F&& task)
+        {
+            using Result = std::invoke_result_t<F>;
+            auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+            auto future   = packaged->get_future();
+            enqueue([packaged]() { (*packaged)(); });
+            return future;
+        }
+
+        // runs body(i) for every i in [0, count) on the workers and the calling thread, returns once all are done.
+        // Must not be called from inside a pool task.
+        static void parallelFor(uint count, const std::function<void(uint index)>& body);
+
+        static uint getWorkerCount();
+
+    private:
+        static void enqueue(std::function<void()> task);
+    };
+} // namespace Hub
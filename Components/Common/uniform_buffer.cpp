@@ -1,4 +1,5 @@
 #include "uniform_buffer.h"
+#include "gl_state.h"
 
 namespace Hub
 {
@@ -17,7 +18,7 @@ namespace Hub
 
     void UniformBuffer::bindBufferRange(unsigned int point, unsigned int offset, unsigned int size)
     {
-        glBindBufferRange(buffer_t::UniformBuffer, point, _obj, offset, size);
+        GLState::bindBufferRange(buffer_t::UniformBuffer, point, _obj, offset, size);
     }
 
     UniformBuffer::UniformBuffer() : Buffer(buffer_t::UniformBuffer) {}
@@ -19,6 +19,8 @@ namespace Hub
         void bindBufferRange(unsigned int point, unsigned int offset, unsigned int size);
 
     private:
+        template <typename>
+        friend class HandlePool;
         UniformBuffer();
         UniformBuffer(const void* data, size_t length, BufferUsage::buffer_usage_t usage);
     };
@@ -0,0 +1,62 @@
+#include "uniform_ring.h"
+#include "gl_state.h"
+
+namespace Hub
+{
+    SPUniformRing UniformRing::create(size_t frameSize, uint frameCount)
+    {
+        return SPUniformRing(new UniformRing(frameSize, frameCount));
+    }
+
+    void UniformRing::beginFrame()
+    {
+        _buffer->beginFrame();
+    }
+
+    UniformRing::Slice UniformRing::push(const void* data, size_t length)
+    {
+        auto allocation = _buffer->write(data, length, _alignment);
+        if (!allocation.ptr)
+        {
+            return Slice();
+        }
+        return {allocation.offset, allocation.length};
+    }
+
+    void UniformRing::flush()
+    {
+        _buffer->flush();
+    }
+
+    void UniformRing::bind(uint point, const Slice& slice) const
+    {
+        if (slice.isValid())
+        {
+            GLState::bindBufferRange(GL_UNIFORM_BUFFER, point, *_buffer, slice.offset, slice.size);
+        }
+    }
+
+    void UniformRing::endFrame()
+    {
+        _buffer->endFrame();
+    }
+
+    size_t UniformRing::getOffsetAlignment() const
+    {
+        return _alignment;
+    }
+
+    const SPStreamingBuffer& UniformRing::getBuffer() const
+    {
+        return _buffer;
+    }
+
+    UniformRing::UniformRing(size_t frameSize, uint frameCount)
+    {
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        _alignment = alignment > 0 ? static_cast<size_t>(alignment) : 256;
+        // keep every region start aligned as well, slices are offset from the start of the buffer
+        _buffer = StreamingBuffer::create(Buffer::UniformBuffer, Std140::alignUp(frameSize, _alignment), frameCount);
+    }
+} // namespace Hub
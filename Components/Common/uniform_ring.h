@@ -0,0 +1,54 @@
+#pragma once
+#include "utils.h"
+#include "std140.h"
+#include "streaming_buffer.h"
+#include <memory>
+#include <type_traits>
+
+namespace Hub
+{
+    class UniformRing;
+    using SPUniformRing = std::shared_ptr<UniformRing>;
+
+    // Per-frame uniform data on top of a StreamingBuffer. Every block pushed in a frame gets its own slice,
+    // aligned to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, and draws select theirs with bindBufferRange:
+    //   beginFrame() -> push()... -> flush() -> bind() + draw... -> endFrame()
+    class UniformRing
+    {
+    public:
+        struct Slice
+        {
+            size_t offset = 0;
+            size_t size   = 0;
+
+            bool isValid() const
+            {
+                return size != 0;
+            }
+        };
+
+        static SPUniformRing create(size_t frameSize, uint frameCount = 3);
+
+        void  beginFrame();
+        Slice push(const void* data, size_t length);
+        void  flush();
+        void  bind(uint point, const Slice& slice) const;
+        void  endFrame();
+
+        template <typename T>
+        Slice push(const T& block)
+        {
+            static_assert(std::is_base_of_v<Std140::Block, T>, "uniform blocks must derive from Std140::Block");
+            return push(&block, sizeof(T));
+        }
+
+        size_t                   getOffsetAlignment() const;
+        const SPStreamingBuffer& getBuffer() const;
+
+    private:
+        UniformRing(size_t frameSize, uint frameCount);
+
+        SPStreamingBuffer _buffer;
+        size_t            _alignment;
+    };
+} // namespace Hub
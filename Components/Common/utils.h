@@ -9,6 +9,8 @@
 
 namespace Hub
 {
+    using uint = unsigned int;
+
     namespace Type
     {
         enum type_t
@@ -21,11 +23,29 @@ namespace Hub
             UnsignedInt   = GL_UNSIGNED_INT,
             Float         = GL_FLOAT,
             Double        = GL_DOUBLE,
+            HalfFloat     = GL_HALF_FLOAT,
+            Int2101010Rev = GL_INT_2_10_10_10_REV, // all four components packed in 4 bytes
         };
 
-    }
-
-    using uint = unsigned int;
+        // bytes per component, packed types report the size of the whole attribute
+        inline uint sizeOf(type_t type)
+        {
+            switch (type)
+            {
+                case Byte:
+                case UnsignedByte:
+                    return 1;
+                case Short:
+                case UnsignedShort:
+                case HalfFloat:
+                    return 2;
+                case Double:
+                    return 8;
+                default:
+                    return 4;
+            }
+        }
+    } // namespace Type
 
     using Atrribute = GLint;
     using Uniform   = GLint;
@@ -1,4 +1,7 @@
 #include "vertex_array.h"
+#include "gl_state.h"
+#include "gl_extensions.h"
+#include "gl_deletion_queue.h"
 
 namespace Hub
 {
@@ -9,7 +12,8 @@ namespace Hub
 
     VertexArray::~VertexArray()
     {
-        glDeleteVertexArrays(1, &_obj);
+        GLState::onDeleteVertexArray(_obj);
+        GLDeletionQueue::release(GLObject::VertexArray, _obj);
     }
 
     VertexArray::operator GLuint() const
@@ -19,32 +23,112 @@ namespace Hub
 
     void VertexArray::bindAttribute(const Atrribute&    atrribute,
                                     uint                count,
-                                    const VertexBuffer& buffer,
+                                    const Buffer&       buffer,
                                     Type::type_t        type,
                                     uint                stride,
                                     intptr_t            offset)
     {
-        glBindVertexArray(_obj);
-        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        if (_dsa)
+        {
+            // one binding point per attribute keeps the old glVertexAttribPointer semantics
+            uint bindingStride = stride != 0 ? stride : count * Type::sizeOf(type);
+            glVertexArrayVertexBuffer(_obj, atrribute, buffer, offset, bindingStride);
+            glVertexArrayAttribFormat(_obj, atrribute, count, type, GL_FALSE, 0);
+            glVertexArrayAttribBinding(_obj, atrribute, atrribute);
+            glEnableVertexArrayAttrib(_obj, atrribute);
+            return;
+        }
+        GLState::bindVertexArray(_obj);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, buffer);
         glEnableVertexAttribArray(atrribute);
         glVertexAttribPointer(atrribute, count, type, GL_FALSE, stride, (GLvoid*)(offset));
     }
 
+    void VertexArray::bindLayout(const VertexLayout& layout, const Buffer& buffer, intptr_t offset)
+    {
+        if (_dsa)
+        {
+            setFormat(layout);
+            bindVertexBuffer(buffer, offset, layout.getStride());
+            return;
+        }
+        GLState::bindVertexArray(_obj);
+        GLState::bindBuffer(GL_ARRAY_BUFFER, buffer);
+        for (const auto& element : layout)
+        {
+            glEnableVertexAttribArray(element.attribute);
+            glVertexAttribPointer(element.attribute,
+                                  element.count,
+                                  element.type,
+                                  element.normalized ? GL_TRUE : GL_FALSE,
+                                  layout.getStride(),
+                                  (GLvoid*)(offset + element.offset));
+        }
+    }
+
+    void VertexArray::setFormat(const VertexLayout& layout)
+    {
+        GLboolean normalized;
+        if (_dsa)
+        {
+            for (const auto& element : layout)
+            {
+                normalized = element.normalized ? GL_TRUE : GL_FALSE;
+                glVertexArrayAttribFormat(
+                    _obj, element.attribute, element.count, element.type, normalized, element.offset);
+                glVertexArrayAttribBinding(_obj, element.attribute, 0);
+                glEnableVertexArrayAttrib(_obj, element.attribute);
+            }
+            return;
+        }
+        GLState::bindVertexArray(_obj);
+        for (const auto& element : layout)
+        {
+            normalized = element.normalized ? GL_TRUE : GL_FALSE;
+            glVertexAttribFormat(element.attribute, element.count, element.type, normalized, element.offset);
+            glVertexAttribBinding(element.attribute, 0);
+            glEnableVertexAttribArray(element.attribute);
+        }
+    }
+
+    void VertexArray::bindVertexBuffer(const Buffer& buffer, intptr_t offset, uint stride)
+    {
+        if (_dsa)
+        {
+            glVertexArrayVertexBuffer(_obj, 0, buffer, offset, stride);
+            return;
+        }
+        GLState::bindVertexArray(_obj);
+        glBindVertexBuffer(0, buffer, offset, stride);
+    }
+
     void VertexArray::bindElements(const ElementBuffer& element)
     {
-        glBindVertexArray(_obj);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element);
+        if (_dsa)
+        {
+            glVertexArrayElementBuffer(_obj, element);
+            return;
+        }
+        GLState::bindVertexArray(_obj);
+        GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, element);
     }
 
     void VertexArray::bindTransformFeedback(uint index, const VertexBuffer& buffer)
     {
-        glBindVertexArray(_obj);
-        glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, index, buffer);
+        GLState::bindVertexArray(_obj);
+        GLState::bindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, index, buffer);
     }
 
-    VertexArray::VertexArray()
+    VertexArray::VertexArray() : _dsa(GLExtensions::get().directStateAccess)
     {
-        glGenVertexArrays(1, &_obj);
+        if (_dsa)
+        {
+            glCreateVertexArrays(1, &_obj);
+        }
+        else
+        {
+            glGenVertexArrays(1, &_obj);
+        }
     }
 
 } // namespace Hub
\ No newline at end of file
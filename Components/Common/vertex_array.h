@@ -2,6 +2,7 @@
 #include "utils.h"
 #include "vertex_buffer.h"
 #include "element_buffer.h"
+#include "vertex_layout.h"
 #include <memory>
 
 namespace Hub
@@ -17,15 +18,24 @@ namespace Hub
         operator GLuint() const;
         void bindAttribute(const Atrribute&    atrribute,
                            uint                count,
-                           const VertexBuffer& buffer,
+                           const Buffer&       buffer,
                            Type::type_t        type,
                            uint                stride,
                            intptr_t            offset);
+        // every element of the layout sourced from buffer, starting at offset
+        void bindLayout(const VertexLayout& layout, const Buffer& buffer, intptr_t offset = 0);
+        // attribute formats only, all reading from binding 0, the buffer is attached with bindVertexBuffer
+        // requires GLExtensions::vertexAttribBinding
+        void setFormat(const VertexLayout& layout);
+        void bindVertexBuffer(const Buffer& buffer, intptr_t offset, uint stride);
         void bindElements(const ElementBuffer& element);
         void bindTransformFeedback(uint index, const VertexBuffer& buffer);
 
     private:
+        template <typename>
+        friend class HandlePool;
         VertexArray();
         GLuint _obj;
+        bool   _dsa; // created with glCreateVertexArrays, set up without binding
     };
 } // namespace Hub
\ No newline at end of file
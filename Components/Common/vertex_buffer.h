@@ -17,6 +17,8 @@ namespace Hub
         ~VertexBuffer();
 
     private:
+        template <typename>
+        friend class HandlePool;
         VertexBuffer();
         VertexBuffer(const void* data, size_t length, BufferUsage::buffer_usage_t usage);
     };
@@ -0,0 +1,121 @@
+#include "vertex_format_cache.h"
+#include "gl_extensions.h"
+#include "gl_state.h"
+#include <unordered_map>
+
+namespace Hub
+{
+    namespace
+    {
+        const GLuint Unbound = 0xFFFFFFFF;
+
+        struct SharedEntry
+        {
+            SPVertexArray vao;
+            GLuint        vertices = Unbound;
+            GLuint        elements = Unbound;
+        };
+
+        struct BufferKey
+        {
+            VertexLayout layout;
+            GLuint       vertices;
+            GLuint       elements;
+
+            bool operator==(const BufferKey& other) const = default;
+        };
+
+        struct BufferKeyHash
+        {
+            size_t operator()(const BufferKey& key) const
+            {
+                size_t value = key.layout.hash();
+                value ^= std::hash<GLuint>()(key.vertices) + 0x9e3779b9 + (value << 6) + (value >> 2);
+                value ^= std::hash<GLuint>()(key.elements) + 0x9e3779b9 + (value << 6) + (value >> 2);
+                return value;
+            }
+        };
+
+        struct Cache
+        {
+            std::unordered_map<VertexLayout, SharedEntry>               shared;
+            std::unordered_map<BufferKey, SPVertexArray, BufferKeyHash> prebuilt;
+        };
+
+        Cache& cache()
+        {
+            static Cache s_cache;
+            return s_cache;
+        }
+    } // namespace
+
+    void VertexFormatCache::bind(const VertexLayout& layout, const Buffer& vertices, const ElementBuffer* elements)
+    {
+        GLuint elementName = elements ? static_cast<GLuint>(*elements) : 0;
+
+        if (!GLExtensions::get().vertexAttribBinding)
+        {
+            auto& vao = cache().prebuilt[{layout, vertices, elementName}];
+            if (!vao)
+            {
+                vao = VertexArray::create();
+                vao->bindLayout(layout, vertices);
+                if (elements)
+                {
+                    vao->bindElements(*elements);
+                }
+            }
+            GLState::bindVertexArray(*vao);
+            return;
+        }
+
+        auto& entry = cache().shared[layout];
+        if (!entry.vao)
+        {
+            entry.vao = VertexArray::create();
+            entry.vao->setFormat(layout);
+        }
+        GLState::bindVertexArray(*entry.vao);
+        if (entry.vertices != vertices)
+        {
+            entry.vao->bindVertexBuffer(vertices, 0, layout.getStride());
+            entry.vertices = vertices;
+        }
+        if (entry.elements != elementName)
+        {
+            GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementName);
+            entry.elements = elementName;
+        }
+    }
+
+    void VertexFormatCache::onDeleteBuffer(GLuint buffer)
+    {
+        auto& c = cache();
+        for (auto& [layout, entry] : c.shared)
+        {
+            // the VAO keeps the old storage alive until something else is bound, force a rebind
+            if (entry.vertices == buffer)
+            {
+                entry.vertices = Unbound;
+            }
+            if (entry.elements == buffer)
+            {
+                entry.elements = Unbound;
+            }
+        }
+        std::erase_if(c.prebuilt, [buffer](const auto& item) {
+            return item.first.vertices == buffer || item.first.elements == buffer;
+        });
+    }
+
+    void VertexFormatCache::clear()
+    {
+        cache().shared.clear();
+        cache().prebuilt.clear();
+    }
+
+    uint VertexFormatCache::getVertexArrayCount()
+    {
+        return static_cast<uint>(cache().shared.size() + cache().prebuilt.size());
+    }
+} // namespace Hub
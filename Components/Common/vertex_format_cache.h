@@ -0,0 +1,26 @@
+#pragma once
+#include "utils.h"
+#include "vertex_array.h"
+#include "vertex_layout.h"
+
+namespace Hub
+{
+    // Shares vertex array objects between draws with the same VertexLayout.
+    // With vertex attrib binding (4.3) there is one VAO per layout and switching meshes only rebinds the
+    // vertex and element buffers. On 3.3 the format cannot be split from the buffer, so a pre-built VAO is
+    // kept per (layout, vertex buffer, element buffer).
+    class VertexFormatCache
+    {
+    public:
+        // binds a VAO that sources layout from vertices and elements, ready to draw
+        static void bind(const VertexLayout& layout, const Buffer& vertices, const ElementBuffer* elements = nullptr);
+
+        // called when a buffer name is released, GL may hand it out again
+        static void onDeleteBuffer(GLuint buffer);
+
+        // destroys the cached VAOs, must run while the context is still current
+        static void clear();
+
+        static uint getVertexArrayCount();
+    };
+} // namespace Hub
@@ -0,0 +1,124 @@
+#pragma once
+#include "utils.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace Hub
+{
+    struct VertexElement
+    {
+        Atrribute    attribute  = 0;
+        uint         count      = 0;
+        Type::type_t type       = Type::Float;
+        bool         normalized = false;
+        uint         offset     = 0; // relative to the start of the vertex
+
+        constexpr bool operator==(const VertexElement& other) const = default;
+    };
+
+    // Interleaved vertex format sourced from a single buffer binding. Declared once next to the vertex struct:
+    //   constexpr VertexLayout layout = VertexLayout(sizeof(V)).add(0, 3, Type::Float, offsetof(V, position));
+    class VertexLayout
+    {
+    public:
+        static constexpr uint MaxElements = 8;
+
+        constexpr VertexLayout() = default;
+        constexpr explicit VertexLayout(uint stride) : _stride(stride) {}
+
+        constexpr VertexLayout
+        add(Atrribute attribute, uint count, Type::type_t type, uint offset, bool normalized = false) const
+        {
+            VertexLayout layout               = *this;
+            layout._elements[layout._count++] = {attribute, count, type, normalized, offset};
+            return layout;
+        }
+
+        constexpr uint getStride() const
+        {
+            return _stride;
+        }
+
+        constexpr uint getCount() const
+        {
+            return _count;
+        }
+
+        constexpr const VertexElement& operator[](uint index) const
+        {
+            return _elements[index];
+        }
+
+        constexpr const VertexElement* begin() const
+        {
+            return _elements.data();
+        }
+
+        constexpr const VertexElement* end() const
+        {
+            return _elements.data() + _count;
+        }
+
+        // FNV-1a over the used elements
+        constexpr size_t hash() const
+        {
+            uint64_t value = 14695981039346656037ull;
+            auto     mix   = [&value](uint64_t field) {
+                value ^= field;
+                value *= 1099511628211ull;
+            };
+            mix(_stride);
+            mix(_count);
+            for (const auto& element : *this)
+            {
+                mix(static_cast<uint64_t>(element.attribute));
+                mix(element.count);
+                mix(static_cast<uint64_t>(element.type));
+                mix(element.normalized);
+                mix(element.offset);
+            }
+            return static_cast<size_t>(value);
+        }
+
+        constexpr bool operator==(const VertexLayout& other) const = default;
+
+    private:
+        std::array<VertexElement, MaxElements> _elements{};
+        uint                                   _count  = 0;
+        uint                                   _stride = 0;
+    };
+
+    // layouts of the tightly packed float arrays the demos declare inline, named after what the attributes hold
+    namespace VertexLayouts
+    {
+        constexpr uint floatSize = sizeof(float);
+
+        // skyboxes and untextured cubes
+        constexpr VertexLayout position = VertexLayout(3 * floatSize).add(0, 3, Type::Float, 0);
+        // textured cubes and planes
+        constexpr VertexLayout positionTexCoords =
+            VertexLayout(5 * floatSize).add(0, 3, Type::Float, 0).add(1, 2, Type::Float, 3 * floatSize);
+        // lit cubes without textures
+        constexpr VertexLayout positionNormal =
+            VertexLayout(6 * floatSize).add(0, 3, Type::Float, 0).add(1, 3, Type::Float, 3 * floatSize);
+        // lit textured cubes and planes
+        constexpr VertexLayout positionNormalTexCoords = VertexLayout(8 * floatSize)
+                                                             .add(0, 3, Type::Float, 0)
+                                                             .add(1, 3, Type::Float, 3 * floatSize)
+                                                             .add(2, 2, Type::Float, 6 * floatSize);
+        // full screen quads in normalized device coordinates
+        constexpr VertexLayout screenQuad =
+            VertexLayout(4 * floatSize).add(0, 2, Type::Float, 0).add(1, 2, Type::Float, 2 * floatSize);
+    } // namespace VertexLayouts
+} // namespace Hub
+
+template <>
+struct std::hash<Hub::VertexLayout>
+{
+    size_t operator()(const Hub::VertexLayout& layout) const
+    {
+        return layout.hash();
+    }
+};
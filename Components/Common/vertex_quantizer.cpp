@@ -0,0 +1,130 @@
+#include "vertex_quantizer.h"
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace Hub
+{
+    namespace
+    {
+        uint32_t packNormal(const Vector3& normal)
+        {
+            float length = glm::length(normal);
+            return glm::packSnorm3x10_1x2(Vector4(length > 0.f ? normal / length : normal, 0.f));
+        }
+
+        Vector3 unpackNormal(uint32_t normal)
+        {
+            return Vector3(glm::unpackSnorm3x10_1x2(normal));
+        }
+
+        // unorm16 of position inside bounds, an empty extent maps to 0
+        void quantizePosition(const Vector3& position, const MeshData::Bounds& bounds, uint16_t* result)
+        {
+            Vector3 extent = bounds.max - bounds.min;
+            for (int i = 0; i < 3; ++i)
+            {
+                float t   = extent[i] > 0.f ? (position[i] - bounds.min[i]) / extent[i] : 0.f;
+                result[i] = static_cast<uint16_t>(std::clamp(t, 0.f, 1.f) * 65535.f + 0.5f);
+            }
+            result[3] = 0;
+        }
+
+        Vector3 dequantizePosition(const uint16_t* position, const MeshData::Bounds& bounds)
+        {
+            Vector3 t(position[0], position[1], position[2]);
+            return t / 65535.f * (bounds.max - bounds.min) + bounds.min;
+        }
+    } // namespace
+
+    VertexQuantizer::Error VertexQuantizer::pack(MeshData::VertexFormat::format_t     format,
+                                                 const std::vector<MeshData::Vertex>& vertices,
+                                                 const MeshData::Bounds&              bounds,
+                                                 std::vector<unsigned char>&          packed)
+    {
+        size_t stride = MeshData::layoutOf(format).getStride();
+        packed.resize(vertices.size() * stride);
+
+        Error error;
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const auto&    vertex = vertices[i];
+            unsigned char* target = packed.data() + i * stride;
+            switch (format)
+            {
+                case MeshData::VertexFormat::Packed: {
+                    MeshData::PackedVertex result;
+                    result.position  = vertex.position;
+                    result.normal    = packNormal(vertex.normal);
+                    result.texCoords = glm::packHalf2x16(vertex.texCoords);
+                    std::memcpy(target, &result, sizeof(result));
+                    break;
+                }
+                case MeshData::VertexFormat::Quantized: {
+                    MeshData::QuantizedVertex result;
+                    quantizePosition(vertex.position, bounds, result.position);
+                    result.normal    = packNormal(vertex.normal);
+                    result.texCoords = glm::packHalf2x16(vertex.texCoords);
+                    std::memcpy(target, &result, sizeof(result));
+                    break;
+                }
+                default:
+                    std::memcpy(target, &vertex, sizeof(vertex));
+                    break;
+            }
+
+            auto decoded   = unpack(format, target, bounds);
+            error.position = std::max(error.position, glm::distance(vertex.position, decoded.position));
+            if (glm::length(vertex.normal) > 0.f && glm::length(decoded.normal) > 0.f)
+            {
+                float cosine = glm::dot(glm::normalize(vertex.normal), glm::normalize(decoded.normal));
+                error.normal = std::max(error.normal, glm::degrees(std::acos(std::clamp(cosine, -1.f, 1.f))));
+            }
+            Vector2 uvError = glm::abs(vertex.texCoords - decoded.texCoords);
+            error.texCoords = std::max(error.texCoords, std::max(uvError.x, uvError.y));
+        }
+        return error;
+    }
+
+    MeshData::Vertex
+    VertexQuantizer::unpack(MeshData::VertexFormat::format_t format, const void* vertex, const MeshData::Bounds& bounds)
+    {
+        MeshData::Vertex result;
+        switch (format)
+        {
+            case MeshData::VertexFormat::Packed: {
+                MeshData::PackedVertex source;
+                std::memcpy(&source, vertex, sizeof(source));
+                result.position  = source.position;
+                result.normal    = unpackNormal(source.normal);
+                result.texCoords = glm::unpackHalf2x16(source.texCoords);
+                break;
+            }
+            case MeshData::VertexFormat::Quantized: {
+                MeshData::QuantizedVertex source;
+                std::memcpy(&source, vertex, sizeof(source));
+                result.position  = dequantizePosition(source.position, bounds);
+                result.normal    = unpackNormal(source.normal);
+                result.texCoords = glm::unpackHalf2x16(source.texCoords);
+                break;
+            }
+            default:
+                std::memcpy(&result, vertex, sizeof(result));
+                break;
+        }
+        return result;
+    }
+
+    const char* VertexQuantizer::getName(MeshData::VertexFormat::format_t format)
+    {
+        switch (format)
+        {
+            case MeshData::VertexFormat::Packed:
+                return "packed";
+            case MeshData::VertexFormat::Quantized:
+                return "quantized";
+            default:
+                return "full";
+        }
+    }
+} // namespace Hub
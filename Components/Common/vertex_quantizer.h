@@ -0,0 +1,34 @@
+#pragma once
+#include "utils.h"
+#include "mesh.h"
+#include <vector>
+
+namespace Hub
+{
+    // Packs MeshData::Vertex arrays into the compact MeshData::VertexFormat layouts and measures what the
+    // packing cost. Nothing here touches GL, it runs on the ThreadPool with the rest of the import.
+    class VertexQuantizer
+    {
+    public:
+        // largest error over the packed vertices
+        struct Error
+        {
+            float position  = 0.f; // distance, in model units
+            float normal    = 0.f; // angle, in degrees
+            float texCoords = 0.f; // per component
+        };
+
+        // packed receives vertices.size() vertices of format. Quantized positions are relative to bounds, the
+        // same bounds have to be given to the Mesh drawing them.
+        static Error pack(MeshData::VertexFormat::format_t     format,
+                          const std::vector<MeshData::Vertex>& vertices,
+                          const MeshData::Bounds&              bounds,
+                          std::vector<unsigned char>&          packed);
+
+        // inverse of pack for one vertex, what the vertex shader sees
+        static MeshData::Vertex
+        unpack(MeshData::VertexFormat::format_t format, const void* vertex, const MeshData::Bounds& bounds);
+
+        static const char* getName(MeshData::VertexFormat::format_t format);
+    };
+} // namespace Hub
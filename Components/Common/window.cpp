@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "window.h"
+#include "gl_context.h"
 #include <iostream>
 
 namespace Hub
@@ -53,6 +54,7 @@ namespace Hub
             std::cerr << "Failed to init GLAD" << std::endl;
             return Status::status_t::FAILED;
         }
+        GLContext::load((GLADloadproc)glfwGetProcAddress);
 
         // Viewport: 告诉OpenGL渲染窗口的尺寸大小：视口
         glViewport(0, 0, _width, _height);
@@ -71,6 +73,7 @@ namespace Hub
     void Window::swapBuffer()
     {
         glfwSwapBuffers(_window);
+        GLContext::endFrame();
     }
 
     void Window::pollEvents()
@@ -110,7 +113,11 @@ namespace Hub
         if (this->_window != nullptr)
         {
             setShouldClose(true);
+            GLContext::release();
+            // release() deletes GL objects, so the context goes last
             glfwDestroyWindow(this->_window);
+            this->_window = nullptr;
+            glfwTerminate();
         }
     }
 } // namespace Hub
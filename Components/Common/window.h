@@ -21,11 +21,14 @@ namespace Hub
 
     public:
         Window(int width = 800, int height = 600, std::string name = "Window");
+        // releases the queued GL objects and caches while the context is current, then terminates GLFW
         ~Window();
 
         Status::status_t init();
         WindowHandle     getNativeHandle() const;
 
+        // swaps and ends the frame: frame counters, deferred deletion and shader hot reload run here, so render
+        // loops call this rather than glfwSwapBuffers
         void swapBuffer();
         void pollEvents();
 
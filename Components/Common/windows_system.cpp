@@ -1,5 +1,6 @@
 #include "windows_system.h"
 #include "logger/logger.h"
+#include "gl_context.h"
 
 namespace zh
 {
@@ -41,6 +42,7 @@ namespace zh
             LOG_FATAL("Failed to init GLAD.");
             return;
         }
+        Hub::GLContext::load((GLADloadproc)glfwGetProcAddress);
 
         // glViewport(0, 0, _width, _height);
         glfwSetWindowUserPointer(_window, this);
@@ -109,9 +111,21 @@ namespace zh
 
     void WindowSystem::onClose() {}
 
+    void WindowSystem::swapBuffer()
+    {
+        glfwSwapBuffers(_window);
+        Hub::GLContext::endFrame();
+    }
+
     void WindowSystem::clear()
     {
-        glfwDestroyWindow(_window);
+        if (_window != nullptr)
+        {
+            // release() deletes GL objects, so the context goes last
+            Hub::GLContext::release();
+            glfwDestroyWindow(_window);
+            _window = nullptr;
+        }
         glfwTerminate();
     }
 } // namespace zh
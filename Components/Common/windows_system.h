@@ -22,6 +22,9 @@ namespace zh
 
         void initialize(WindowInfo windowInfo);
 
+        // presents the frame and runs the end-of-frame hooks of the GL wrappers
+        void swapBuffer();
+
         static void onKey(GLFWwindow* window, int key, int scancode, int action, int mods);
         static void onMouseButton(GLFWwindow* window, int button, int action, int mods);
         static void onScroll(GLFWwindow* window, double xoffset, double yoffset);
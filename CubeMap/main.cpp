@@ -1,4 +1,5 @@
 ﻿#include "window.h"
+#include "gl_state.h"
 #include "shader.h"
 #include "camera.h"
 #include "vertex_array.h"
@@ -167,8 +168,7 @@ namespace Hub
 		
 		auto cubeVAO = VertexArray::create();
 		auto cubeVBO = VertexBuffer::create(cubeVertices, sizeof(cubeVertices), BufferUsage::StaticDraw);
-		cubeVAO->bindAttribute(0, 3, *cubeVBO, Type::Float, 6 * sizeof(float), 0 * sizeof(float));
-		cubeVAO->bindAttribute(1, 3, *cubeVBO, Type::Float, 6 * sizeof(float), 3 * sizeof(float));
+		cubeVAO->bindLayout(VertexLayouts::positionNormal, *cubeVBO);
 
 		const char* filePath = "../Asset/container2.png";	
 		auto cubeTexture = Texture::create(filePath);
@@ -183,7 +183,7 @@ namespace Hub
 
 		auto skyboxVAO = VertexArray::create();
 		auto skyboxVBO = VertexBuffer::create(skyboxVertices, sizeof(skyboxVertices), BufferUsage::StaticDraw);
-		skyboxVAO->bindAttribute(0, 3, *skyboxVBO, Type::Float, 3 * sizeof(float), 0 * sizeof(float));
+		skyboxVAO->bindLayout(VertexLayouts::position, *skyboxVBO);
 		
 		auto cubeMap = Texture::create(texture_t::TextureCubeMap);
 		std::vector<std::string> faces = 
@@ -235,16 +235,16 @@ namespace Hub
 			shader.setMatirx4("view", view);
 			shader.setMatirx4("projection", projection);
 
-			glBindVertexArray(*cubeVAO);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_CUBE_MAP, *cubeMap);
+			GLState::bindVertexArray(*cubeVAO);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_CUBE_MAP, *cubeMap);
 			auto model = glm::mat4(1.0f);
 			model = glm::translate(model, glm::vec3(-1.0f, 0.0f, -1.0f));
 			shader.setMatirx4("model", model);
 			shader.setVec3("cameraPos", camera.getPosition());
 			shader.setInt("skybox", 0);
 			glDrawArrays(GL_TRIANGLES, 0, 36);
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
 			// skybox
 			skyboxShader.use();
@@ -253,15 +253,14 @@ namespace Hub
 			skyboxShader.setMatirx4("projection", projection);
 			skyboxShader.setInt("skybox", 0);
 
-			glBindVertexArray(*skyboxVAO);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_CUBE_MAP, *cubeMap);
+			GLState::bindVertexArray(*skyboxVAO);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_CUBE_MAP, *cubeMap);
 			glDrawArrays(GL_TRIANGLES, 0, 36);
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
-			glfwSwapBuffers(window);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 }
 
@@ -1,4 +1,5 @@
 ﻿#include "application.h"
+#include "gl_state.h"
 #include "shader.h"
 #include "vertex_array.h"
 #include "vertex_buffer.h"
@@ -47,9 +48,9 @@ namespace Hub
 
             // Draw
             shader.use();
-            glBindVertexArray(*VAO);
+            GLState::bindVertexArray(*VAO);
             glDrawArrays(GL_TRIANGLES, 0, 3);
-            glBindVertexArray(0);
+            GLState::bindVertexArray(0);
         }
 
     private:
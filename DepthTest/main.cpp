@@ -1,4 +1,5 @@
 ﻿#include "window.h"
+#include "gl_state.h"
 #include "shader.h"
 #include "camera.h"
 #include "vertex_array.h"
@@ -133,13 +134,11 @@ namespace Hub
 
 		auto cubeVAO = VertexArray::create();
 		auto cubeVBO = VertexBuffer::create(cubeVertices, sizeof(cubeVertices), BufferUsage::StaticDraw);
-		cubeVAO->bindAttribute(0, 3, *cubeVBO, Type::Float, 5 * sizeof(float), 0 * sizeof(float));
-		cubeVAO->bindAttribute(1, 2, *cubeVBO, Type::Float, 5 * sizeof(float), 3 * sizeof(float));
+		cubeVAO->bindLayout(VertexLayouts::positionTexCoords, *cubeVBO);
 
 		auto planeVAO = VertexArray::create();
 		auto planeVBO = VertexBuffer::create(planeVertices, sizeof(planeVertices), BufferUsage::StaticDraw);
-		planeVAO->bindAttribute(0, 3, *planeVBO, Type::Float, 5 * sizeof(float), 0 * sizeof(float));
-		planeVAO->bindAttribute(1, 2, *planeVBO, Type::Float, 5 * sizeof(float), 3 * sizeof(float));
+		planeVAO->bindLayout(VertexLayouts::positionTexCoords, *planeVBO);
 		
 		const char* filePath = "../Asset/container2.png";	
 		auto cubeTexture = Texture::create(filePath);
@@ -185,9 +184,9 @@ namespace Hub
 			shader.setMatirx4("projection", projection);
 
 			// cube
-			glBindVertexArray(*cubeVAO);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *cubeTexture);
+			GLState::bindVertexArray(*cubeVAO);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *cubeTexture);
 			auto model = glm::mat4(1.0f);
 			model = glm::translate(model, glm::vec3(-1.0f, 0.0f, -1.0f));
 			shader.setMatirx4("model", model);
@@ -198,15 +197,14 @@ namespace Hub
 			glDrawArrays(GL_TRIANGLES, 0, 36);
 
 			// floor
-			glBindVertexArray(*planeVAO);
-			glBindTexture(GL_TEXTURE_2D, *planeTexture);
+			GLState::bindVertexArray(*planeVAO);
+			GLState::bindTexture(GL_TEXTURE_2D, *planeTexture);
 			shader.setMatirx4("model", glm::mat4(1.0f));
 			glDrawArrays(GL_TRIANGLES, 0, 6);
 
 
-			glfwSwapBuffers(window);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 }
 
@@ -1,10 +1,10 @@
 ﻿#include "window.h"
+#include "gl_state.h"
 #include "shader.h"
 #include "camera.h"
 #include "vertex_array.h"
 #include "vertex_buffer.h"
-#include "frame_buffer.h"
-#include "render_buffer.h"
+#include "render_target_pool.h"
 #include "texture.h"
 
 
@@ -147,19 +147,16 @@ namespace Hub
 
 		auto cubeVAO = VertexArray::create();
 		auto cubeVBO = VertexBuffer::create(cubeVertices, sizeof(cubeVertices), BufferUsage::StaticDraw);
-		cubeVAO->bindAttribute(0, 3, *cubeVBO, Type::Float, 5 * sizeof(float), 0 * sizeof(float));
-		cubeVAO->bindAttribute(1, 2, *cubeVBO, Type::Float, 5 * sizeof(float), 3 * sizeof(float));
+		cubeVAO->bindLayout(VertexLayouts::positionTexCoords, *cubeVBO);
 
 		auto planeVAO = VertexArray::create();
 		auto planeVBO = VertexBuffer::create(planeVertices, sizeof(planeVertices), BufferUsage::StaticDraw);
-		planeVAO->bindAttribute(0, 3, *planeVBO, Type::Float, 5 * sizeof(float), 0 * sizeof(float));
-		planeVAO->bindAttribute(1, 2, *planeVBO, Type::Float, 5 * sizeof(float), 3 * sizeof(float));
+		planeVAO->bindLayout(VertexLayouts::positionTexCoords, *planeVBO);
 		
 
 		auto quadVAO = VertexArray::create();
 		auto quadVBO = VertexBuffer::create(quadVertices, sizeof(quadVertices), BufferUsage::StaticDraw);
-		quadVAO->bindAttribute(0, 2, *quadVBO, Type::Float, 4 * sizeof(float), 0 * sizeof(float));
-		quadVAO->bindAttribute(1, 2, *quadVBO, Type::Float, 4 * sizeof(float), 2 * sizeof(float));
+		quadVAO->bindLayout(VertexLayouts::screenQuad, *quadVBO);
 
 		const char* filePath = "../Asset/container2.png";	
 		auto cubeTexture = Texture::create(filePath);
@@ -180,25 +177,12 @@ namespace Hub
 		screenShader.use();
 		screenShader.setInt("screenTexture", 0);
 		
-		// framebuffer config
-		auto FBO = FrameBuffer::create();
-		glBindFramebuffer(GL_FRAMEBUFFER, *FBO);
-		// create a color attachment texture
-		auto textureColorbuffer = Texture::create();
-		textureColorbuffer->image2D(nullptr, Format::format_t::RGBA, windowWidth, windowHeight, Type::UnsignedByte);
-		textureColorbuffer->setFilter(Filter::operator_t::Min, Filter::filter_t::Linear);
-		textureColorbuffer->setFilter(Filter::operator_t::Mag, Filter::filter_t::Linear);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, *textureColorbuffer, 0);
-		// create a render object for depth and stencil attachment(we don't sampling there)
-		auto RBO = RenderBuffer::create();
-		glBindRenderbuffer(GL_RENDERBUFFER, *RBO);
-		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, windowWidth, windowHeight);
-		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, *RBO);
-		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-		{
-			std::cout << "ERROR::FRAMEBUFFER:: framebuffer is not complete!" << std::endl;
-		}
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		// framebuffer config: a color attachment texture and a render object for depth and stencil
+		// attachment(we don't sampling there), sized to the window framebuffer
+		auto targets = RenderTargetPool::create();
+		RenderTargetDesc sceneDesc;
+		sceneDesc.format = Format::RGBA;
+		sceneDesc.depth = DepthAttachment::RenderBuffer;
 
 		glfwSetCursorPosCallback(window, mouse_callback);
 		glfwSetScrollCallback(window, scroll_callback);
@@ -211,8 +195,13 @@ namespace Hub
 
 			glfwPollEvents();
 			processInput(window);
+			int width, height;
+			glfwGetFramebufferSize(window, &width, &height);
+			targets->setViewportSize(width, height);
+			auto sceneTarget = targets->acquire(sceneDesc);
+
 			// bind to framebuffer and draw scene as we normally would to color texture
-			glBindFramebuffer(GL_FRAMEBUFFER, *FBO);
+			glBindFramebuffer(GL_FRAMEBUFFER, *sceneTarget->frameBuffer);
 
 			glEnable(GL_DEPTH_TEST); //enable depth testing(is disabled for rendering screen-space quad)
 			// make sure we clear the framebuffer's content
@@ -226,9 +215,9 @@ namespace Hub
 			shader.setMatirx4("projection", projection);
 
 			// cube
-			glBindVertexArray(*cubeVAO);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *cubeTexture);
+			GLState::bindVertexArray(*cubeVAO);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *cubeTexture);
 			auto model = glm::mat4(1.0f);
 			model = glm::translate(model, glm::vec3(-1.0f, 0.0f, -1.0f));
 			shader.setMatirx4("model", model);
@@ -239,8 +228,8 @@ namespace Hub
 			glDrawArrays(GL_TRIANGLES, 0, 36);
 
 			// floor
-			glBindVertexArray(*planeVAO);
-			glBindTexture(GL_TEXTURE_2D, *planeTexture);
+			GLState::bindVertexArray(*planeVAO);
+			GLState::bindTexture(GL_TEXTURE_2D, *planeTexture);
 			shader.setMatirx4("model", glm::mat4(1.0f));
 			glDrawArrays(GL_TRIANGLES, 0, 6);
 
@@ -252,14 +241,15 @@ namespace Hub
 
 			screenShader.use();
 			//glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-			glBindVertexArray(*quadVAO);
-			glBindTexture(GL_TEXTURE_2D, *textureColorbuffer); // use the color attachment as the texture of the quad plane
+			GLState::bindVertexArray(*quadVAO);
+			GLState::bindTexture(GL_TEXTURE_2D, *sceneTarget->colorTexture); // use the color attachment as the texture of the quad plane
 			glDrawArrays(GL_TRIANGLES, 0, 6);
 
-			glBindVertexArray(0);
-			glfwSwapBuffers(window);
+			GLState::bindVertexArray(0);
+			targets->release(sceneTarget);
+			targets->newFrame();
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 }
 
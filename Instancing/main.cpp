@@ -1,4 +1,5 @@
 #include "window.h"
+#include "gl_state.h"
 #include "shader.h"
 #include "camera.h"
 #include "vertex_array.h"
@@ -129,14 +130,13 @@ namespace Hub
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 			shader.use();
-			glBindVertexArray(*VAO);
+			GLState::bindVertexArray(*VAO);
 			glDrawArraysInstanced(GL_TRIANGLES, 0, 6, 100);
 
 
-			glBindVertexArray(0);
-			glfwSwapBuffers(window);
+			GLState::bindVertexArray(0);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 }
 
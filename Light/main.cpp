@@ -1,4 +1,5 @@
 ﻿#include "window.h"
+#include "gl_state.h"
 #include "shader.h"
 #include "camera.h"
 
@@ -124,9 +125,9 @@ namespace Hub
 		GLuint cubeVAO, VBO;
 
 		glGenVertexArrays(1, &cubeVAO);
-		glBindVertexArray(cubeVAO);
+		GLState::bindVertexArray(cubeVAO);
 		glGenBuffers(1, &VBO);
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, VBO);
 		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
 
@@ -135,15 +136,15 @@ namespace Hub
 
 		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
 		glEnableVertexAttribArray(1);
-		glBindVertexArray(0);
+		GLState::bindVertexArray(0);
 
 		GLuint lightVAO; // 光源
 		glGenVertexArrays(1, &lightVAO);
-		glBindVertexArray(lightVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		GLState::bindVertexArray(lightVAO);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, VBO);
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
 		glEnableVertexAttribArray(0);
-		glBindVertexArray(0);
+		GLState::bindVertexArray(0);
 
 		glEnable(GL_DEPTH_TEST);
 		glfwSetCursorPosCallback(window, mouse_callback);
@@ -182,9 +183,9 @@ namespace Hub
 			lightShader.setMatirx4("view", view);
 			lightShader.setMatirx4("projection", projection);
 
-			glBindVertexArray(cubeVAO);
+			GLState::bindVertexArray(cubeVAO);
 			glDrawArrays(GL_TRIANGLES, 0, 36);
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
 			lampShader.use();
 			lampShader.setMatirx4("view", view);
@@ -193,17 +194,16 @@ namespace Hub
 			model = glm::translate(model, lightPos);
 			model = glm::scale(model, glm::vec3(0.2f));
 			lampShader.setMatirx4("model", model);
-			glBindVertexArray(lightVAO);
+			GLState::bindVertexArray(lightVAO);
 			glDrawArrays(GL_TRIANGLES, 0, 36);
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
-			glfwSwapBuffers(window);
+			hWindow.swapBuffer();
 		}
 
 		glDeleteBuffers(1, &VBO);
 		glDeleteVertexArrays(1, &cubeVAO);
 		glDeleteVertexArrays(1, &lightVAO);
-		glfwTerminate();
 	}
 	
 }
@@ -1,4 +1,5 @@
 ﻿#include "window.h"
+#include "gl_state.h"
 #include "image.h"
 #include "texture.h"
 #include "shader.h"
@@ -140,9 +141,7 @@ namespace Hub
 
 		auto VBO = VertexBuffer::create(vertices, sizeof(vertices), BufferUsage::StaticDraw);
 		auto cubeVAO = VertexArray::create();
-		cubeVAO->bindAttribute(0, 3, *VBO, Type::Float, 8 * sizeof(float), 0 * sizeof(float));
-		cubeVAO->bindAttribute(1, 3, *VBO, Type::Float, 8 * sizeof(float), 3 * sizeof(float));
-		cubeVAO->bindAttribute(2, 2, *VBO, Type::Float, 8 * sizeof(float), 6 * sizeof(float));
+		cubeVAO->bindLayout(VertexLayouts::positionNormalTexCoords, *VBO);
 
 		auto lightVAO = VertexArray::create();
 		lightVAO->bindAttribute(0, 3, *VBO, Type::Float, 8 * sizeof(float), 0 * sizeof(float));
@@ -175,11 +174,11 @@ namespace Hub
 
 
 			lightShader.use();
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *diffuseMap);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *diffuseMap);
 			lightShader.setInt("material.diffuse", 0);
-			glActiveTexture(GL_TEXTURE1);
-			glBindTexture(GL_TEXTURE_2D, *specularMap);
+			GLState::activeTexture(GL_TEXTURE1);
+			GLState::bindTexture(GL_TEXTURE_2D, *specularMap);
 			lightShader.setInt("material.specular", 1);
 
 
@@ -214,7 +213,7 @@ namespace Hub
 			
 			lightShader.setMatirx4("view", view);
 			lightShader.setMatirx4("projection", projection);
-			glBindVertexArray(*cubeVAO);
+			GLState::bindVertexArray(*cubeVAO);
 			for (size_t i = 0; i < positions.size(); ++i)
 			{
 				glm::mat4 model(1.0f);
@@ -226,7 +225,7 @@ namespace Hub
 			}
 			
 			
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
 			lampShader.use();
 			lampShader.setMatirx4("view", view);
@@ -235,13 +234,12 @@ namespace Hub
 			model = glm::translate(model, lightPos);
 			model = glm::scale(model, glm::vec3(0.2f));
 			lampShader.setMatirx4("model", model);
-			glBindVertexArray(*lightVAO);
+			GLState::bindVertexArray(*lightVAO);
 			glDrawArrays(GL_TRIANGLES, 0, 36);
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
-			glfwSwapBuffers(window);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 }
 
@@ -1,4 +1,5 @@
 ﻿#include "window.h"
+#include "gl_state.h"
 #include "image.h"
 #include "texture.h"
 #include "shader.h"
@@ -73,7 +74,8 @@ namespace Hub
 		Window hWindow(windowWidth, windowHeight);
 		auto window = hWindow.getNativeHandle();
 
-		Shader lightShader("./shader/light.vs", "./shader/light.fs");
+		// the point light count is injected into light.fs as a define
+		Shader lightShader("./shader/light.vs", "./shader/light.fs", nullptr, { { "NR_POINT_LIGHTS", "4" } });
 		Shader lampShader("./shader/lamp.vs", "./shader/lamp.fs");
 
 		//cube
@@ -140,9 +142,7 @@ namespace Hub
 
 		auto VBO = VertexBuffer::create(vertices, sizeof(vertices), BufferUsage::StaticDraw);
 		auto cubeVAO = VertexArray::create();
-		cubeVAO->bindAttribute(0, 3, *VBO, Type::Float, 8 * sizeof(float), 0 * sizeof(float));
-		cubeVAO->bindAttribute(1, 3, *VBO, Type::Float, 8 * sizeof(float), 3 * sizeof(float));
-		cubeVAO->bindAttribute(2, 2, *VBO, Type::Float, 8 * sizeof(float), 6 * sizeof(float));
+		cubeVAO->bindLayout(VertexLayouts::positionNormalTexCoords, *VBO);
 
 		auto lightVAO = VertexArray::create();
 		lightVAO->bindAttribute(0, 3, *VBO, Type::Float, 8 * sizeof(float), 0 * sizeof(float));
@@ -172,6 +172,25 @@ namespace Hub
 			glm::vec3(0.0f,  0.0f, -3.0f)
 		};
 
+		// point light uniform handles, resolved once instead of building the names every frame
+		struct PointLightUniforms
+		{
+			UniformHandle position, ambient, diffuse, specular, constant, linear, quadratic;
+		};
+		std::vector<PointLightUniforms> pointLightUniforms(pointLightPositions.size());
+		for (size_t i = 0; i < pointLightUniforms.size(); ++i)
+		{
+			auto aim = "pointLights[" + std::to_string(i) + "].";
+			auto& uniforms = pointLightUniforms[i];
+			uniforms.position = lightShader.getUniform(aim + "position");
+			uniforms.ambient = lightShader.getUniform(aim + "ambient");
+			uniforms.diffuse = lightShader.getUniform(aim + "diffuse");
+			uniforms.specular = lightShader.getUniform(aim + "specular");
+			uniforms.constant = lightShader.getUniform(aim + "constant");
+			uniforms.linear = lightShader.getUniform(aim + "linear");
+			uniforms.quadratic = lightShader.getUniform(aim + "quadratic");
+		}
+
 		while (!hWindow.shouldClose())
 		{
 			GLfloat currentFrame = glfwGetTime();
@@ -189,11 +208,11 @@ namespace Hub
 
 
 			lightShader.use();
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *diffuseMap);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *diffuseMap);
 			lightShader.setInt("material.diffuse", 0);
-			glActiveTexture(GL_TEXTURE1);
-			glBindTexture(GL_TEXTURE_2D, *specularMap);
+			GLState::activeTexture(GL_TEXTURE1);
+			GLState::bindTexture(GL_TEXTURE_2D, *specularMap);
 			lightShader.setInt("material.specular", 1);
 
 			lightShader.setVec3("material.specular", 0.5f, 0.5f, 0.5f);
@@ -206,19 +225,18 @@ namespace Hub
 			lightShader.setVec3("dirLight.specular", 1.0f, 1.0f, 1.0f);
 
 			// point lights
-			for (auto i = 0; i < 4; ++i)
+			for (size_t i = 0; i < pointLightUniforms.size(); ++i)
 			{
-				auto id = std::to_string(i);
-				auto aim = "pointLights[" + id + "].";
-				lightShader.setVec3((aim + "position").c_str(), pointLightPositions[i]);
+				const auto& uniforms = pointLightUniforms[i];
+				lightShader.setVec3(uniforms.position, pointLightPositions[i]);
 
-				lightShader.setVec3((aim + "ambient").c_str(), 0.05f, 0.05f, 0.05f);
-				lightShader.setVec3((aim + "diffuse").c_str(), 0.8f, 0.8f, 0.8f);
-				lightShader.setVec3((aim + "specular").c_str(), 1.0f, 1.0f, 1.0f);
+				lightShader.setVec3(uniforms.ambient, 0.05f, 0.05f, 0.05f);
+				lightShader.setVec3(uniforms.diffuse, 0.8f, 0.8f, 0.8f);
+				lightShader.setVec3(uniforms.specular, 1.0f, 1.0f, 1.0f);
 
-				lightShader.setFloat((aim + "constant").c_str(), 1.0f);
-				lightShader.setFloat((aim + "linear").c_str(), 0.09f);
-				lightShader.setFloat((aim + "quadratic").c_str(), 0.032f);
+				lightShader.setFloat(uniforms.constant, 1.0f);
+				lightShader.setFloat(uniforms.linear, 0.09f);
+				lightShader.setFloat(uniforms.quadratic, 0.032f);
 			}
 
 			/*lightPos.x = 2.0f * sin(glfwGetTime());
@@ -247,7 +265,7 @@ namespace Hub
 
 			lightShader.setMatirx4("view", view);
 			lightShader.setMatirx4("projection", projection);
-			glBindVertexArray(*cubeVAO);
+			GLState::bindVertexArray(*cubeVAO);
 			for (size_t i = 0; i < cubePositions.size(); ++i)
 			{
 				glm::mat4 model(1.0f);
@@ -257,12 +275,12 @@ namespace Hub
 				lightShader.setMatirx4("model", model);
 				glDrawArrays(GL_TRIANGLES, 0, 36);
 			}
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
 			lampShader.use();
 			lampShader.setMatirx4("view", view);
 			lampShader.setMatirx4("projection", projection);
-			glBindVertexArray(*lightVAO);
+			GLState::bindVertexArray(*lightVAO);
 			for (size_t i = 0; i < 4; ++i)
 			{
 				model = glm::mat4(1.0f);
@@ -271,11 +289,10 @@ namespace Hub
 				lampShader.setMatirx4("model", model);
 				glDrawArrays(GL_TRIANGLES, 0, 36);
 			}
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
-			glfwSwapBuffers(window);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 }
 
@@ -1,4 +1,5 @@
 ﻿#include "window.h"
+#include "gl_state.h"
 #include "shader.h"
 #include "camera.h"
 #include "vertex_array.h"
@@ -122,8 +123,7 @@ namespace Hub
 
 			auto VBO = VertexBuffer::create(vertices, sizeof(vertices), BufferUsage::StaticDraw);
 			auto cubeVAO = VertexArray::create();
-			cubeVAO->bindAttribute(0, 3, *VBO, Type::Float, 6 * sizeof(float), 0 * sizeof(GLfloat));
-			cubeVAO->bindAttribute(1, 3, *VBO, Type::Float, 6 * sizeof(float), 3 * sizeof(GLfloat));
+			cubeVAO->bindLayout(VertexLayouts::positionNormal, *VBO);
 
 			auto lightVAO = VertexArray::create();
 			lightVAO->bindAttribute(0, 3, *VBO, Type::Float, 6 * sizeof(float), 0 * sizeof(GLfloat));
@@ -180,9 +180,9 @@ namespace Hub
 				lightShader.setMatirx4("view", view);
 				lightShader.setMatirx4("projection", projection);
 
-				glBindVertexArray(*cubeVAO);
+				GLState::bindVertexArray(*cubeVAO);
 				glDrawArrays(GL_TRIANGLES, 0, 36);
-				glBindVertexArray(0);
+				GLState::bindVertexArray(0);
 
 				lampShader.use();
 				lampShader.setMatirx4("view", view);
@@ -191,13 +191,12 @@ namespace Hub
 				model = glm::translate(model, lightPos);
 				model = glm::scale(model, glm::vec3(0.2f));
 				lampShader.setMatirx4("model", model);
-				glBindVertexArray(*lightVAO);
+				GLState::bindVertexArray(*lightVAO);
 				glDrawArrays(GL_TRIANGLES, 0, 36);
-				glBindVertexArray(0);
+				GLState::bindVertexArray(0);
 
-				glfwSwapBuffers(window);
+				hWindow.swapBuffer();
 			}
-			glfwTerminate();
 	}
 }
 
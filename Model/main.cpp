@@ -1,6 +1,7 @@
 ﻿#include "window.h"
 #include "model.h"
 #include "shader.h"
+#include "shader_hot_reload.h"
 #include "camera.h"
 #include "image.h"
 #include <iostream>
@@ -73,11 +74,20 @@ namespace Hub
 
 		Image::filpVerticallyOnLoadEnable(true);
 
-		// shader
-		Shader ourShader("./shader/shader.vs", "./shader/shader.fs");
+		// 16 byte vertices: unorm16 positions, 10_10_10_2 normals, half uv. Full keeps the 32 byte float vertex
+		MeshData::ImportOptions importOptions;
+		importOptions.vertexFormat = MeshData::VertexFormat::Quantized;
+
+		// shader, built in the background while the model loads; until it is ready draws use a placeholder
+		Shader ourShader("./shader/shader.vs", "./shader/shader.fs", nullptr, MeshData::definesFor(importOptions.vertexFormat), ShaderBuild::Async);
+		// edit shader.vs/fs while running, the program is rebuilt on the next swap
+		ShaderHotReload::add(ourShader);
 
 		const char* filePath = "../Asset/backpack/backpack.obj";
-		Model ourModel(filePath);
+		// 导入时生成LOD, 绘制时按屏幕误差选择
+		Model ourModel(filePath, importOptions);
+		// 每帧收集所有模型的网格, 按程序/材质/深度排序后提交
+		auto drawList = DrawList::create();
 		
 		glEnable(GL_DEPTH_TEST);
 		glfwSetCursorPosCallback(window, mouse_callback);
@@ -103,15 +113,15 @@ namespace Hub
 			model = glm::scale(model, glm::vec3(0.2f, 0.2f, 0.2f));
 			ourShader.setMatirx4("projection", projection);
 			ourShader.setMatirx4("view", view);
-			ourShader.setMatirx4("model", model);
 
-			ourModel.draw(ourShader);
+			drawList->begin(camera.getPosition());
+			ourModel.submit(*drawList, ourShader, camera, model, static_cast<float>(windowHeight));
+			drawList->submit();
 
 			// swap the screen buffers
-			glfwSwapBuffers(window);
+			hWindow.swapBuffer();
 
 		}
-		glfwTerminate();
 	}
 }
 int main()
@@ -8,8 +8,18 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 
+#ifdef HUB_QUANTIZED_POSITION
+// unorm16 positions relative to the mesh bounds
+uniform vec3 positionScale;
+uniform vec3 positionOffset;
+#endif
+
 void main()
 {	
 	TexCoords = texCoords;
-	gl_Position = projection * view * model * vec4(position, 1.0f);
+	vec3 localPosition = position;
+#ifdef HUB_QUANTIZED_POSITION
+	localPosition = localPosition * positionScale + positionOffset;
+#endif
+	gl_Position = projection * view * model * vec4(localPosition, 1.0f);
 }
\ No newline at end of file
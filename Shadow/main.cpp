@@ -1,5 +1,7 @@
 #include "window.h"
+#include "gl_state.h"
 #include "shader.h"
+#include "shader_variants.h"
 #include "camera.h"
 #include "vertex_array.h"
 #include "vertex_buffer.h"
@@ -97,10 +99,8 @@ namespace Hub
 		VAO = VertexArray::create();
 		auto VBO = VertexBuffer::create(planeVertices, sizeof(planeVertices), BufferUsage::StaticDraw);
 
-		VAO->bindAttribute(0, 3, *VBO, Type::Float, 8 * sizeof(float), 0);
-		VAO->bindAttribute(1, 3, *VBO, Type::Float, 8 * sizeof(float), 3 * sizeof(float));
-		VAO->bindAttribute(2, 2, *VBO, Type::Float, 8 * sizeof(float), 6 * sizeof(float));
-		glBindVertexArray(0);
+		VAO->bindLayout(VertexLayouts::positionNormalTexCoords, *VBO);
+		GLState::bindVertexArray(0);
 	}
 
 	// renders a 1x1 3D cube in NDC
@@ -156,15 +156,13 @@ namespace Hub
 		{
 			cubeVAO = VertexArray::create();
 			auto cubeVBO = VertexBuffer::create(cubeVertices, sizeof(cubeVertices), BufferUsage::StaticDraw);
-			cubeVAO->bindAttribute(0, 3, *cubeVBO, Type::Float, 8 * sizeof(float), 0);
-			cubeVAO->bindAttribute(1, 3, *cubeVBO, Type::Float, 8 * sizeof(float), 3 * sizeof(float));
-			cubeVAO->bindAttribute(2, 2, *cubeVBO, Type::Float, 8 * sizeof(float), 6 * sizeof(float));
-			glBindVertexArray(0);
+			cubeVAO->bindLayout(VertexLayouts::positionNormalTexCoords, *cubeVBO);
+			GLState::bindVertexArray(0);
 		}
 		
-		glBindVertexArray(*cubeVAO);
+		GLState::bindVertexArray(*cubeVAO);
 		glDrawArrays(GL_TRIANGLES, 0, 36);
-		glBindVertexArray(0);
+		GLState::bindVertexArray(0);
 	}
 	void renderScene(Shader& shader, VertexArray& vao)
 	{
@@ -173,13 +171,19 @@ namespace Hub
 		//shader.setMatirx4("model", model);
 		//glBindVertexArray(vao);
 		//glDrawArrays(GL_TRIANGLES, 0, 6);
+		// deferred shaders upload the uniforms changed since the last cube right before drawing it
+		auto draw = [&]()
+		{
+			shader.flush();
+			renderCube();
+		};
 		// room
 		glm::mat4 model = glm::mat4(1.0f);
 		model = glm::scale(model, glm::vec3(5.0f));
 		shader.setMatirx4("model", model);
 		glDisable(GL_CULL_FACE);
 		shader.setInt("reverse_normal", 1);
-		renderCube();
+		draw();
 		shader.setInt("reverse_normal", 0);
 		glEnable(GL_CULL_FACE);
 		// cubes
@@ -187,28 +191,28 @@ namespace Hub
 		model = glm::translate(model, glm::vec3(4.0f, -3.5f, 0.0));
 		model = glm::scale(model, glm::vec3(0.5f));
 		shader.setMatirx4("model", model);
-		renderCube();
+		draw();
 		model = glm::mat4(1.0f);
 		model = glm::translate(model, glm::vec3(2.0f, 3.0f, 1.0));
 		model = glm::scale(model, glm::vec3(0.75f));
 		shader.setMatirx4("model", model);
-		renderCube();
+		draw();
 		model = glm::mat4(1.0f);
 		model = glm::translate(model, glm::vec3(-3.0f, -1.0f, 0.0));
 		model = glm::scale(model, glm::vec3(0.5f));
 		shader.setMatirx4("model", model);
-		renderCube();
+		draw();
 		model = glm::mat4(1.0f);
 		model = glm::translate(model, glm::vec3(-1.5f, 1.0f, 1.5));
 		model = glm::scale(model, glm::vec3(0.5f));
 		shader.setMatirx4("model", model);
-		renderCube();
+		draw();
 		model = glm::mat4(1.0f);
 		model = glm::translate(model, glm::vec3(-1.5f, 2.0f, -3.0));
 		model = glm::rotate(model, glm::radians(60.0f), glm::normalize(glm::vec3(1.0, 0.0, 1.0)));
 		model = glm::scale(model, glm::vec3(0.75f));
 		shader.setMatirx4("model", model);
-		renderCube();
+		draw();
 	}
 
 	SPVertexArray quadVAO;
@@ -225,13 +229,12 @@ namespace Hub
 			};
 			quadVAO = VertexArray::create();
 			auto quadVBO = VertexBuffer::create(quadVertices, sizeof(quadVertices), BufferUsage::StaticDraw);
-			quadVAO->bindAttribute(0, 3, *quadVBO, Type::Float, 5 * sizeof(float), 0);
-			quadVAO->bindAttribute(1, 2, *quadVBO, Type::Float, 5 * sizeof(float), 3 * sizeof(float));
-			glBindVertexArray(0);
+			quadVAO->bindLayout(VertexLayouts::positionTexCoords, *quadVBO);
+			GLState::bindVertexArray(0);
 		}
-		glBindVertexArray(*quadVAO);
+		GLState::bindVertexArray(*quadVAO);
 		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-		glBindVertexArray(0);
+		GLState::bindVertexArray(0);
 	}
 
 	void test()
@@ -267,11 +270,9 @@ namespace Hub
 		Color borderColor{ 1.0f, 1.0f, 1.0f, 1.0f };
 		depthMap->setBorderColor(borderColor);
 		// attach depth texture as fbo's depth buffer
-		glBindFramebuffer(GL_FRAMEBUFFER, *depthMapFBO);
-		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, *depthMap, 0);
-		glDrawBuffer(GL_NONE);
-		glReadBuffer(GL_NONE);
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		depthMapFBO->attachTexture(GL_DEPTH_ATTACHMENT, *depthMap);
+		depthMapFBO->setDrawBuffer(GL_NONE);
+		depthMapFBO->setReadBuffer(GL_NONE);
 
 		glEnable(GL_DEPTH_TEST);
 		//glEnable(GL_CULL_FACE);
@@ -314,8 +315,8 @@ namespace Hub
 			glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
 			glBindFramebuffer(GL_FRAMEBUFFER, *depthMapFBO);
 			glClear(GL_DEPTH_BUFFER_BIT);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *floorTexture);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *floorTexture);
 			//glCullFace(GL_FRONT); // solve peter panning issue, but it not work perfectly fine on plane: plane will be removed.
 			renderScene(depthShader, *VAO);
 			//glCullFace(GL_BACK);
@@ -332,10 +333,10 @@ namespace Hub
 			shader.setVec3("viewPos", camera.getPosition());
 			shader.setVec3("lightPos", lightPos);
 			shader.setMatirx4("lightSpaceMatrix", lightSpaceMatrix);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *floorTexture);
-			glActiveTexture(GL_TEXTURE1);
-			glBindTexture(GL_TEXTURE_2D, *depthMap);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *floorTexture);
+			GLState::activeTexture(GL_TEXTURE1);
+			GLState::bindTexture(GL_TEXTURE_2D, *depthMap);
 			renderScene(shader, *VAO);
 
 			//// render depth map to quad for visual debugging
@@ -344,10 +345,9 @@ namespace Hub
 			//glBindTexture(GL_TEXTURE_2D, *depthMap);
 			//renderQuad();
 
-			glBindVertexArray(0);
-			glfwSwapBuffers(window);
+			GLState::bindVertexArray(0);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 
 	void test2()
@@ -356,8 +356,11 @@ namespace Hub
 		auto window = hWindow.getNativeHandle();
 		glfwSetCursorPosCallback(window, mouse_callback);
 		glfwSetScrollCallback(window, scroll_callback);
-		Shader shader("./shader/shader2.vs", "./shader/shader2.fs");
+		// shadows on/off and the filter are compiled variants instead of a uniform branch
+		auto shaderVariants = ShaderVariants::create("./shader/shader2.vs", "./shader/shader2.fs");
+		ShaderDefines shadowDefines = { { "SHADOWS", "" } }; // add SHADOW_SIMPLE or SHADOW_PCF to change the filter
 		Shader depthShader("./shader/cube_mapping_depth.vs", "./shader/cube_mapping_depth.fs", "./shader/cube_mapping_depth.gs");
+		depthShader.setUniformUpdate(UniformUpdate::Deferred);
 
 		generatePlaneVAO();
 
@@ -379,18 +382,12 @@ namespace Hub
 		depthCubeMap->setWrapping(Wrapping::axis_t::S, Wrapping::wrapping_t::ClampEdge);
 		depthCubeMap->setWrapping(Wrapping::axis_t::T, Wrapping::wrapping_t::ClampEdge);
 
-		glBindFramebuffer(GL_FRAMEBUFFER, *depthMapFBO);
-		glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, *depthCubeMap, 0);
-		glDrawBuffer(GL_NONE);
-		glReadBuffer(GL_NONE);
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		depthMapFBO->attachTexture(GL_DEPTH_ATTACHMENT, *depthCubeMap);
+		depthMapFBO->setDrawBuffer(GL_NONE);
+		depthMapFBO->setReadBuffer(GL_NONE);
 
 		glEnable(GL_DEPTH_TEST);
 
-		shader.use();
-		shader.setInt("diffuseTexture", 0);
-		shader.setInt("depthMap", 1);
-
 		glm::vec3 lightPos(0.0f, 0.0f, 0.0f);
 		float aspect = SHADOW_WIDTH / SHADOW_HEIGHT * 1.0f;
 
@@ -453,24 +450,26 @@ namespace Hub
 			// configure shader and matrix
 			auto view = camera.getViewMatrix();
 			auto projection = camera.getProjectionMatrix(aspect);
+			Shader& shader = shaderVariants->get(shadows ? shadowDefines : ShaderDefines());
+			shader.setUniformUpdate(UniformUpdate::Deferred);
 			shader.use();
+			shader.setInt("diffuseTexture", 0);
+			shader.setInt("depthMap", 1);
 			shader.setMatirx4("view", view);
 			shader.setMatirx4("projection", projection);
 			// set light uniform
 			shader.setVec3("viewPos", camera.getPosition());
 			shader.setVec3("lightPos", lightPos);
 			shader.setFloat("far_plane", far);
-			shader.setInt("shadows", shadows);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *floorTexture);
-			glActiveTexture(GL_TEXTURE1);
-			glBindTexture(GL_TEXTURE_CUBE_MAP, *depthCubeMap);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *floorTexture);
+			GLState::activeTexture(GL_TEXTURE1);
+			GLState::bindTexture(GL_TEXTURE_CUBE_MAP, *depthCubeMap);
 			renderScene(shader, *VAO);
 
-			glBindVertexArray(0);
-			glfwSwapBuffers(window);
+			GLState::bindVertexArray(0);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 		
 	}
 
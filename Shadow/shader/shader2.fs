@@ -15,7 +15,6 @@ uniform vec3 lightPos;
 uniform vec3 viewPos;
 
 uniform float far_plane;
-uniform bool shadows;
 
 float pcf(vec3 fragPos)
 {
@@ -83,13 +82,16 @@ float simpleShadow(vec3 fragPos)
 	return shadow;
 }
 
+// filter picked by the variant defines: SHADOW_SIMPLE, SHADOW_PCF, pcf2 otherwise
 float shadowCalculation(vec3 fragPos)
 {
-	//return simpleShadow(fragPos);
-
-	//return pcf(fragPos);
-
+#if defined(SHADOW_SIMPLE)
+	return simpleShadow(fragPos);
+#elif defined(SHADOW_PCF)
+	return pcf(fragPos);
+#else
 	return pcf2(fragPos);
+#endif
 }
 
 void main()
@@ -111,7 +113,11 @@ void main()
 	spec = pow(max(dot(normal, halfwayDir), 0.0), 64.0);
 	vec3 specular = spec * lightColor;
 	// calculate shadow
-	float shadow = shadows ? shadowCalculation(fs_in.FragPos) : 0.0;
+#ifdef SHADOWS
+	float shadow = shadowCalculation(fs_in.FragPos);
+#else
+	float shadow = 0.0;
+#endif
 	vec3 lighting = (ambient + (1.0 - shadow) * (diffuse + specular)) * color;
 
 	FragColor = vec4(lighting, 1.0);
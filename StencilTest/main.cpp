@@ -1,4 +1,5 @@
 ﻿#include "window.h"
+#include "gl_state.h"
 #include "shader.h"
 #include "camera.h"
 #include "vertex_array.h"
@@ -134,13 +135,11 @@ namespace Hub
 
 		auto cubeVAO = VertexArray::create();
 		auto cubeVBO = VertexBuffer::create(cubeVertices, sizeof(cubeVertices), BufferUsage::StaticDraw);
-		cubeVAO->bindAttribute(0, 3, *cubeVBO, Type::Float, 5 * sizeof(float), 0 * sizeof(float));
-		cubeVAO->bindAttribute(1, 2, *cubeVBO, Type::Float, 5 * sizeof(float), 3 * sizeof(float));
+		cubeVAO->bindLayout(VertexLayouts::positionTexCoords, *cubeVBO);
 
 		auto planeVAO = VertexArray::create();
 		auto planeVBO = VertexBuffer::create(planeVertices, sizeof(planeVertices), BufferUsage::StaticDraw);
-		planeVAO->bindAttribute(0, 3, *planeVBO, Type::Float, 5 * sizeof(float), 0 * sizeof(float));
-		planeVAO->bindAttribute(1, 2, *planeVBO, Type::Float, 5 * sizeof(float), 3 * sizeof(float));
+		planeVAO->bindLayout(VertexLayouts::positionTexCoords, *planeVBO);
 		
 		const char* filePath = "../Asset/container2.png";	
 		auto cubeTexture = Texture::create(filePath);
@@ -191,8 +190,8 @@ namespace Hub
 			// floor
 			glStencilMask(0x00);
 			
-			glBindVertexArray(*planeVAO);
-			glBindTexture(GL_TEXTURE_2D, *planeTexture);
+			GLState::bindVertexArray(*planeVAO);
+			GLState::bindTexture(GL_TEXTURE_2D, *planeTexture);
 			shader.setMatirx4("model", glm::mat4(1.0f));
 			glDrawArrays(GL_TRIANGLES, 0, 6);
 
@@ -201,9 +200,9 @@ namespace Hub
 			glStencilFunc(GL_ALWAYS, 1, 0xFF);
 			glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
 		
-			glBindVertexArray(*cubeVAO);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *cubeTexture);
+			GLState::bindVertexArray(*cubeVAO);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *cubeTexture);
 
 			auto model = glm::mat4(1.0f);
 			model = glm::translate(model, glm::vec3(-1.0f, 0.0f, -1.0f));
@@ -224,9 +223,9 @@ namespace Hub
 			glStencilMask(0x00);
 			glDisable(GL_DEPTH_TEST); // 保证放大后的不被floor覆盖
 
-			glBindVertexArray(*cubeVAO);
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, *cubeTexture);
+			GLState::bindVertexArray(*cubeVAO);
+			GLState::activeTexture(GL_TEXTURE0);
+			GLState::bindTexture(GL_TEXTURE_2D, *cubeTexture);
 			
 			float scaleRatio = 1.05f;
 			model = glm::mat4(1.0f);
@@ -244,11 +243,10 @@ namespace Hub
 			glStencilFunc(GL_ALWAYS, 1, 0xFF);
 			glStencilMask(0xFF);
 			glEnable(GL_DEPTH_TEST);
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
-			glfwSwapBuffers(window);
+			hWindow.swapBuffer();
 		}
-		glfwTerminate();
 	}
 }
 
@@ -1,4 +1,5 @@
 ﻿#include "window.h"
+#include "gl_state.h"
 #include "image.h"
 #include "vertex_array.h"
 #include "vertex_buffer.h"
@@ -40,9 +41,9 @@ namespace Hub
 		VAO->bindAttribute(2, 2, *VBO, Type::Float, 8 * sizeof(float), 6 * sizeof(float));
 		
 		// unbind
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
 		// 解绑VAO
-		glBindVertexArray(0);
+		GLState::bindVertexArray(0);
 
 		const char* filePath = "../Asset/container.jpg";
 		auto texture1 = Texture::create(filePath);
@@ -61,11 +62,11 @@ namespace Hub
 		
 		ourShader.use(); // 设置shader属性前需要激活程序
 		// 绑定纹理
-		glActiveTexture(GL_TEXTURE0); // 使用一个纹理时默认激活
-		glBindTexture(GL_TEXTURE_2D, *texture1);
+		GLState::activeTexture(GL_TEXTURE0); // 使用一个纹理时默认激活
+		GLState::bindTexture(GL_TEXTURE_2D, *texture1);
 		ourShader.setInt("ourTexture1", 0);
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, *texture2);
+		GLState::activeTexture(GL_TEXTURE1);
+		GLState::bindTexture(GL_TEXTURE_2D, *texture2);
 		ourShader.setInt("ourTexture2", 1);
 
 		while (!glfwWindowShouldClose(window)) // 使图像不立即关闭
@@ -83,16 +84,15 @@ namespace Hub
 			ourShader.setMatirx4("transform", trans);
 			// Draw
 			//ourShader.use(); // 激活着色程序
-			glBindVertexArray(*VAO);
+			GLState::bindVertexArray(*VAO);
 			//glDrawArrays(GL_TRIANGLES, 0, 3); // 0: 顶点起始索引，3绘制个数
 			glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0); // 6个点，索引类型为unsigned int, offset = 0
-			glBindVertexArray(0);
+			GLState::bindVertexArray(0);
 
 			// swap the screen buffers
-			glfwSwapBuffers(window);
+			hWindow.swapBuffer();
 
 		}
-		glfwTerminate();
 	}
 }
 int main()